@@ -97,6 +97,19 @@
 //  Notes: A fragment shader probably contains a line like this:
 //          gl_FragColor = u_text_color * texture2D(u_texture_id, v_tex_coord).a;
 //
+//         Outlined or drop-shadowed text (from fpf_create_outline_texture() or
+//         fpf_create_shadow_texture()) draws in a single pass with an RG texture:
+//          vec2 texel = texture2D(u_texture_id, v_tex_coord).rg;
+//          gl_FragColor = mix(u_outline_color, u_text_color, texel.r) * texel.g;
+//         The quad for an outlined glyph is 8x8 pixels, placed one pixel up and left of the 6x6 cell.
+//
+//         Distance field text (from fpf_create_sdf_texture()) draws at any scale from one
+//         texture, with GL_LINEAR filtering. Square distances keep the corners square, and
+//         fwidth() keeps the edge one screen pixel wide:
+//          float d = texture2D(u_texture_id, v_tex_coord).a;
+//          float w = 0.5 * fwidth(d);
+//          gl_FragColor = u_text_color * smoothstep(0.5 - w, 0.5 + w, d);
+//
 
 #ifndef FIVEPIXELFONT_H
 #define FIVEPIXELFONT_H
@@ -129,9 +142,227 @@ typedef enum
 #define FPF_TEXTURE_WIDTH   64u
 #define FPF_TEXTURE_HEIGHT  64u
 
+// The atlas holds 99 glyphs: the 95 printable ASCII characters, a fallback glyph (for every other
+// character) and the three cursor glyphs.
+#define FPF_GLYPH_COUNT     99u
+
+// The outline texture atlas is a two channel (RG8) 128x64 texture. Each glyph gets an 8x8 cell with
+// the 6x6 glyph in the middle, so there's room for a 1-pixel outline all the way around.
+#define FPF_OUTLINE_GLYPH_WIDTH     8u
+#define FPF_OUTLINE_GLYPH_HEIGHT    8u
+#define FPF_OUTLINE_TEXTURE_WIDTH   128u
+#define FPF_OUTLINE_TEXTURE_HEIGHT  64u
+
+// The signed distance field atlas (see fpf_create_sdf_texture()) has FPF_SDF_TEXELS_PER_PIXEL
+// texels per font pixel, and each glyph's cell is padded by spread texels on every side, so its
+// size depends on the spread.
+#ifndef FPF_SDF_TEXELS_PER_PIXEL
+#define FPF_SDF_TEXELS_PER_PIXEL        4u
+#endif
+#define FPF_SDF_MAX_SPREAD              32u
+#define FPF_SDF_CELLS_PER_ROW           10u
+#define FPF_SDF_CELL_SIZE(spread)       (FPF_GLYPH_WIDTH * FPF_SDF_TEXELS_PER_PIXEL + 2u * (spread))
+#define FPF_SDF_TEXTURE_WIDTH(spread)   (FPF_SDF_CELLS_PER_ROW * FPF_SDF_CELL_SIZE(spread))
+#define FPF_SDF_TEXTURE_HEIGHT(spread)  \
+    (((FPF_GLYPH_COUNT + FPF_SDF_CELLS_PER_ROW - 1) / FPF_SDF_CELLS_PER_ROW) * FPF_SDF_CELL_SIZE(spread))
+
+// Text layout emits each glyph as a quad of two triangles (a triangle list).
+#define FPF_VERTICES_PER_GLYPH      6u
+
+// A vertex of a glyph's quad, as emitted by fpf_layout_text().
+typedef struct
+{
+    float           x;      // Horizontal position in pixels.
+    float           y;      // Vertical position in pixels (grows downward).
+    float           u;      // Horizontal texture coordinate.
+    float           v;      // Vertical texture coordinate.
+    unsigned int    color;  // Text color; passed through untouched (e.g. packed RGBA).
+} fpf_vertex;
+
+// A clip (scissor) rectangle in pixels; the right and bottom edges are exclusive.
+typedef struct
+{
+    int left;
+    int top;
+    int right;
+    int bottom;
+} fpf_clip_rect;
+
+// Software rendering works from a table of glyph bits: FPF_GLYPH_HEIGHT bytes per glyph, one byte
+// per row with the left-most pixel in the most significant bit (see fpf_create_glyph_bits()).
+#define FPF_GLYPH_BITS_SIZE (FPF_GLYPH_COUNT * FPF_GLYPH_HEIGHT)
+
+// Largest scale for fpf_draw_text_*_scaled()
+#define FPF_MAX_SCALE       8u
+
+// Subpixel masks (see fpf_create_subpixel_masks()) hold every glyph at each of up to
+// FPF_MAX_SUBPIXEL_PHASES horizontal offsets within a pixel, as FPF_GLYPH_HEIGHT rows of
+// FPF_SUBPIXEL_MASK_WIDTH alpha bytes (a glyph shifted right spills into a seventh column; the
+// eighth is padding, so a row is blended in one 8-byte step).
+#define FPF_MAX_SUBPIXEL_PHASES             4u
+#define FPF_SUBPIXEL_MASK_WIDTH             8u
+#define FPF_SUBPIXEL_MASKS_SIZE(phase_count) \
+    ((phase_count) * FPF_GLYPH_COUNT * FPF_GLYPH_HEIGHT * FPF_SUBPIXEL_MASK_WIDTH)
+
+// Each row of the texture atlas decompresses to 64 bits (one bit per texel).
+#define FPF_ROW_BITS_SIZE   (FPF_TEXTURE_WIDTH / 8u)
+
+// The compressed font image (see fpf_compressed_font), as a list of bytes so it can also be
+// decoded at compile time (see fpf_static_text.hpp). A zero byte is followed by a count of zero
+// bytes; every other byte is eight texels.
+#define FPF_COMPRESSED_FONT_BYTES \
+    0, 1, 133, 20, 123, 34, 8, 16, 128, 0, 1, 133, 62, 163, 69, 16, 32, 64, \
+    0, 1, 128, 20, 112, 130, 0, 1, 32, 64, 0, 2, 62, 41, 101, 0, 1, 32, 64, \
+    0, 1, 128, 20, 242, 98, 128, 16, 128, 0, 8, 168, 0, 3, 39, 8, 49, 128, \
+    112, 128, 0, 2, 73, 152, 72, 64, 249, 192, 28, 0, 1, 138, 136, 16, 128, \
+    112, 130, 0, 1, 1, 12, 136, 32, 64, 168, 4, 0, 1, 34, 7, 28, 121, 128, \
+    0, 8, 49, 194, 30, 97, 128, 0, 1, 16, 0, 1, 81, 4, 2, 146, 66, 8, 33, \
+    192, 121, 142, 4, 97, 192, 0, 1, 64, 0, 1, 16, 73, 8, 144, 66, 8, 33, \
+    192, 17, 134, 8, 96, 64, 16, 16, 0, 9, 65, 135, 28, 241, 239, 62, 249, \
+    224, 32, 64, 162, 138, 8, 160, 130, 0, 1, 16, 134, 190, 242, 8, 188, \
+    242, 96, 32, 10, 162, 138, 8, 160, 130, 32, 64, 135, 34, 241, 239, 62, \
+    129, 224, 0, 8, 137, 195, 164, 130, 40, 156, 241, 192, 136, 129, 40, \
+    131, 108, 162, 138, 32, 248, 129, 48, 130, 170, 162, 242, 32, 136, 137, \
+    40, 130, 41, 162, 130, 64, 137, 198, 36, 242, 40, 156, 129, 160, 0, 8, \
+    241, 239, 162, 138, 40, 162, 113, 192, 138, 2, 34, 138, 37, 20, 17, 0, \
+    1, 241, 194, 34, 138, 162, 8, 33, 0, 1, 160, 34, 34, 82, 165, 8, 65, 0, \
+    1, 147, 194, 28, 33, 72, 136, 113, 192, 0, 8, 129, 194, 0, 1, 32, 8, 0, \
+    1, 16, 0, 1, 64, 69, 0, 1, 17, 206, 12, 16, 128, 32, 64, 0, 1, 2, 73, \
+    16, 113, 64, 16, 64, 0, 1, 2, 73, 16, 145, 128, 9, 192, 62, 1, 174, 12, \
+    112, 192, 0, 8, 16, 196, 8, 17, 2, 0, 3, 33, 68, 0, 1, 1, 2, 52, 96, \
+    128, 112, 199, 8, 17, 66, 42, 81, 64, 32, 68, 136, 81, 130, 34, 81, 64, \
+    33, 132, 136, 33, 66, 34, 80, 128, 0, 16, 96, 197, 12, 113, 37, 34, 81, \
+    64, 81, 70, 8, 33, 37, 42, 33, 64, 96, 196, 4, 33, 37, 42, 32, 128, 64, \
+    68, 12, 16, 194, 20, 81, 0, 10, 66, 16, 3, 224, 63, 128, 0, 1, 48, 130, \
+    8, 82, 32, 63, 128, 0, 1, 17, 128, 12, 162, 32, 63, 128, 0, 1, 32, 130, \
+    8, 2, 32, 63, 128, 0, 1, 48, 66, 16, 3, 239, 255, 128, 0, 5, 15, 255, \
+    128
+
+// A packed texture atlas holds just the glyphs a target needs (see fpf_plan_packed_atlas()).
+#define FPF_NO_SLOT 0xffu
+typedef struct
+{
+    unsigned char   slots[FPF_GLYPH_COUNT]; // Cell of each glyph (by glyph index) in the packed atlas, or FPF_NO_SLOT.
+    unsigned int    glyph_count;            // Number of glyphs in the packed atlas.
+    unsigned int    cells_per_row;          // Number of glyph cells in each row of the packed atlas.
+    unsigned int    width;                  // Width of the packed atlas in texels.
+    unsigned int    height;                 // Height of the packed atlas in texels.
+} fpf_packed_atlas;
+
+// Text in other encodings is converted to a string of glyph indices. Newlines become
+// FPF_NEWLINE_GLYPH so layout can still start new lines.
+#define FPF_NEWLINE_GLYPH       0xfeu
+#define FPF_ASCII_GLYPH(c)      ((unsigned char)((c) - ' '))
+#define FPF_CURSOR_GLYPH(style) ((unsigned char)(96u + (style)))
+
+// Maps a range of Unicode code points onto an existing glyph (e.g. accented letters onto the plain
+// letter, box-drawing lines onto '-', '|' and '+'). Tables of these must be sorted by code point.
+typedef struct
+{
+    unsigned long   first;          // First code point of the range.
+    unsigned long   last;           // Last code point of the range.
+    unsigned char   glyph_index;    // Glyph drawn for the range.
+} fpf_replacement;
+
+// Pixel formats for rendering text one scanline at a time (see fpf_render_text_scanline()).
+typedef enum
+{
+    FPF_1BPP = 0,   // One bit per pixel, packed, left-most pixel in the most significant bit.
+    FPF_8BPP,       // One byte per pixel.
+    FPF_16BPP       // One unsigned short per pixel (e.g. RGB565).
+} fpf_pixel_format;
+
+// Keeps track of where decompression is in the fpf_compressed_font data, so the atlas can be
+// decompressed one row at a time.
+typedef struct
+{
+    size_t          byte_index;     // Index of the next byte to read from fpf_compressed_font.
+    unsigned int    zero_bytes;     // Number of bytes left in the current run of zeros.
+} fpf_font_decoder;
+
+// #define FPF_STATS to have the library count the work it does. Without FPF_STATS the counting
+// compiles away. The counters are plain (non-atomic) globals, so counting is single-threaded only:
+// with FPF_STATS defined, call the counting functions (layout, drawing, atlas creation and glyph
+// lookups) from one thread at a time, and read the counters on that thread. The add-ons' threaded
+// parts don't count (fpf_push_text(), overlay panel writes, compositor workers; see
+// fpf_end_composite()), but whatever drains or draws them does.
+#ifdef FPF_STATS
+typedef struct
+{
+    size_t  glyphs_emitted;         // Glyphs laid out as quads or drawn in software.
+    size_t  fallback_glyphs;        // Characters that fpf_get_glyph_position() mapped to the fallback glyph.
+    size_t  texture_bytes_written;  // Bytes written by the texture atlas functions.
+    size_t  layout_calls;           // Calls to fpf_layout_text().
+} fpf_stats;
+
+extern fpf_stats fpf_global_stats;
+#endif
+
 // Declarations.
 size_t fpf_create_alpha_texture(unsigned char *const p_alpha_texture, const size_t alpha_texture_size_in_bytes,
                                 const size_t line_pitch, const fpf_y_axis_direction y_axis_direction);
+size_t fpf_create_alpha_texture_streaming(unsigned char *const p_alpha_texture, const size_t alpha_texture_size_in_bytes,
+                                          const size_t line_pitch, const fpf_y_axis_direction y_axis_direction);
+void fpf_init_font_decoder(fpf_font_decoder *const p_decoder);
+void fpf_decode_row_bits(fpf_font_decoder *const p_decoder, unsigned char *const p_row_bits);
+void fpf_seek_font_decoder(fpf_font_decoder *const p_decoder, const unsigned int row);
+size_t fpf_create_partial_alpha_texture(unsigned char *const p_alpha_texture, const size_t alpha_texture_size_in_bytes,
+                                        const size_t line_pitch, const fpf_y_axis_direction y_axis_direction,
+                                        const char *const characters, const size_t length);
+unsigned int fpf_get_code_point_glyph_index(const unsigned long code_point, const fpf_replacement *const p_replacements,
+                                           const size_t replacement_count);
+size_t fpf_utf8_to_glyph_indices(const char *const text, const size_t length,
+                                 const fpf_replacement *const p_replacements, const size_t replacement_count,
+                                 unsigned char *const p_glyph_indices, const size_t max_glyphs,
+                                 size_t *const p_bytes_used);
+size_t fpf_code_page_to_glyph_indices(const char *const text, const size_t length,
+                                      const unsigned short *const p_code_points,
+                                      const fpf_replacement *const p_replacements, const size_t replacement_count,
+                                      unsigned char *const p_glyph_indices, const size_t max_glyphs);
+size_t fpf_layout_glyph_indices(const unsigned char *const p_glyph_indices, const size_t count, const float x,
+                                const float y, const unsigned int color, const fpf_y_axis_direction y_axis_direction,
+                                fpf_vertex *const p_vertices, const size_t max_vertices);
+size_t fpf_layout_utf8_text(const char *const text, const size_t length, const float x, const float y,
+                            const unsigned int color, const fpf_y_axis_direction y_axis_direction,
+                            fpf_vertex *const p_vertices, const size_t max_vertices);
+void fpf_plan_packed_atlas(fpf_packed_atlas *const p_atlas, const char *const characters, const size_t length);
+size_t fpf_create_packed_alpha_texture(const fpf_packed_atlas *const p_atlas, unsigned char *const p_alpha_texture,
+                                       const size_t alpha_texture_size_in_bytes, const size_t line_pitch,
+                                       const fpf_y_axis_direction y_axis_direction);
+void fpf_get_packed_glyph_position(const fpf_packed_atlas *const p_atlas, const char character,
+                                   unsigned int *const x, unsigned int *const y);
+void fpf_get_packed_glyph_dx_texture_coordinates(const fpf_packed_atlas *const p_atlas, const char character,
+                                                 float *const left, float *const top, float *const right,
+                                                 float *const bottom);
+void fpf_get_packed_glyph_gl_texture_coordinates(const fpf_packed_atlas *const p_atlas, const char character,
+                                                 float *const left, float *const top, float *const right,
+                                                 float *const bottom);
+size_t fpf_render_text_scanline(const char *const text, const size_t length, const unsigned int scanline,
+                                const fpf_pixel_format pixel_format, const unsigned int foreground,
+                                const unsigned int background, void *const p_line, const size_t line_size_in_bytes);
+size_t fpf_create_outline_texture(unsigned char *const p_rg_texture, const size_t rg_texture_size_in_bytes,
+                                  const size_t line_pitch, const fpf_y_axis_direction y_axis_direction);
+size_t fpf_create_shadow_texture(unsigned char *const p_rg_texture, const size_t rg_texture_size_in_bytes,
+                                 const size_t line_pitch, const fpf_y_axis_direction y_axis_direction);
+size_t fpf_create_sdf_texture(unsigned char *const p_alpha_texture, const size_t alpha_texture_size_in_bytes,
+                              const size_t line_pitch, const fpf_y_axis_direction y_axis_direction,
+                              const unsigned int spread);
+void fpf_get_glyph_sdf_position(const char character, const unsigned int spread, unsigned int *const x,
+                                unsigned int *const y);
+void fpf_get_glyph_sdf_dx_texture_coordinates(const char character, const unsigned int spread, float *const left,
+                                              float *const top, float *const right, float *const bottom);
+void fpf_get_glyph_sdf_gl_texture_coordinates(const char character, const unsigned int spread, float *const left,
+                                              float *const top, float *const right, float *const bottom);
+void fpf_get_cursor_glyph_sdf_position(const fpf_cursor_style cursor_style, const unsigned int spread,
+                                       unsigned int *const x, unsigned int *const y);
+void fpf_get_cursor_glyph_sdf_dx_texture_coordinates(const fpf_cursor_style cursor_style, const unsigned int spread,
+                                                     float *const left, float *const top, float *const right,
+                                                     float *const bottom);
+void fpf_get_cursor_glyph_sdf_gl_texture_coordinates(const fpf_cursor_style cursor_style, const unsigned int spread,
+                                                     float *const left, float *const top, float *const right,
+                                                     float *const bottom);
+unsigned int fpf_get_glyph_index(const char character);
+unsigned int fpf_get_cursor_glyph_index(const fpf_cursor_style cursor_style);
 void fpf_get_glyph_position(const char character, unsigned int *const x, unsigned int *const y);
 void fpf_get_glyph_dx_texture_coordinates(const char character, float *const left, float *const top,
                                           float *const right, float *const bottom);
@@ -142,6 +373,54 @@ void fpf_get_cursor_glyph_dx_texture_coordinates(const fpf_cursor_style cursor_s
                                                  float *const top, float *const right, float *const bottom);
 void fpf_get_cursor_glyph_gl_texture_coordinates(const fpf_cursor_style cursor_style, float *const left,
                                                  float *const top, float *const right, float *const bottom);
+void fpf_get_glyph_outline_position(const char character, unsigned int *const x, unsigned int *const y);
+void fpf_get_glyph_outline_dx_texture_coordinates(const char character, float *const left, float *const top,
+                                                  float *const right, float *const bottom);
+void fpf_get_glyph_outline_gl_texture_coordinates(const char character, float *const left, float *const top,
+                                                  float *const right, float *const bottom);
+void fpf_get_cursor_glyph_outline_position(const fpf_cursor_style cursor_style, unsigned int *const x,
+                                           unsigned int *const y);
+void fpf_get_cursor_glyph_outline_dx_texture_coordinates(const fpf_cursor_style cursor_style, float *const left,
+                                                         float *const top, float *const right, float *const bottom);
+void fpf_get_cursor_glyph_outline_gl_texture_coordinates(const fpf_cursor_style cursor_style, float *const left,
+                                                         float *const top, float *const right, float *const bottom);
+size_t fpf_layout_text(const char *const text, const size_t length, const float x, const float y,
+                       const unsigned int color, const fpf_y_axis_direction y_axis_direction,
+                       fpf_vertex *const p_vertices, const size_t max_vertices);
+void fpf_emit_quad(fpf_vertex *const p_quad, const float x0, const float y0, const float x1, const float y1,
+                   const float u0, const float v0, const float u1, const float v1, const unsigned int color);
+void fpf_create_glyph_bits(unsigned char *const p_glyph_bits);
+size_t fpf_draw_text_alpha8(const unsigned char *const p_glyph_bits, unsigned char *const p_surface,
+                            const unsigned int width, const unsigned int height, const size_t line_pitch,
+                            const int x, const int y, const char *const text, const size_t length,
+                            const unsigned char alpha);
+size_t fpf_layout_text_clipped(const char *const text, const size_t length, const float x, const float y,
+                               const unsigned int color, const fpf_y_axis_direction y_axis_direction,
+                               const fpf_clip_rect *const p_clip, fpf_vertex *const p_vertices,
+                               const size_t max_vertices, size_t *const p_culled_count);
+size_t fpf_draw_text_alpha8_clipped(const unsigned char *const p_glyph_bits, unsigned char *const p_surface,
+                                    const unsigned int width, const unsigned int height, const size_t line_pitch,
+                                    const int x, const int y, const char *const text, const size_t length,
+                                    const unsigned char alpha, const fpf_clip_rect *const p_clip,
+                                    size_t *const p_culled_count);
+size_t fpf_draw_text_alpha8_scaled(const unsigned char *const p_glyph_bits, unsigned char *const p_surface,
+                                   const unsigned int width, const unsigned int height, const size_t line_pitch,
+                                   const int x, const int y, const char *const text, const size_t length,
+                                   const unsigned char alpha, const unsigned int scale);
+size_t fpf_draw_text_rgba32_scaled(const unsigned char *const p_glyph_bits, void *const p_surface,
+                                   const unsigned int width, const unsigned int height, const size_t line_pitch,
+                                   const int x, const int y, const char *const text, const size_t length,
+                                   const unsigned int color, const unsigned int scale);
+size_t fpf_create_subpixel_masks(unsigned char *const p_masks, const size_t masks_size_in_bytes,
+                                 const unsigned int phase_count);
+size_t fpf_draw_text_alpha8_subpixel(const unsigned char *const p_masks, const unsigned int phase_count,
+                                     unsigned char *const p_surface, const unsigned int width,
+                                     const unsigned int height, const size_t line_pitch, const float x, const int y,
+                                     const char *const text, const size_t length, const unsigned char alpha);
+#ifdef FPF_STATS
+void fpf_get_stats(fpf_stats *const p_stats);
+void fpf_reset_stats(void);
+#endif
 
 #ifdef FPF_IMPLEMENTATION
 
@@ -157,35 +436,86 @@ void fpf_get_cursor_glyph_gl_texture_coordinates(const fpf_cursor_style cursor_s
 #define FPF_assert(expression) assert(expression)
 #endif
 
+// #define your own FPF_PROFILE_BEGIN() and FPF_PROFILE_END() to hook the library's entry points into
+// your own tracing or timing. The name is a string literal of the function's name.
+#ifndef FPF_PROFILE_BEGIN
+#define FPF_PROFILE_BEGIN(name) ((void)0)
+#endif
+#ifndef FPF_PROFILE_END
+#define FPF_PROFILE_END(name) ((void)0)
+#endif
+
+// Counting isn't synchronized; see FPF_STATS.
+#ifdef FPF_STATS
+#define FPF_STAT_ADD(counter, amount) (fpf_global_stats.counter += (amount))
+#else
+#define FPF_STAT_ADD(counter, amount) ((void)sizeof(amount))
+#endif
+
+// #define your own FPF_memcpy() to override the include of memory.h for the default memcpy().
+#ifndef FPF_memcpy
+#include <memory.h> // For memcpy().
+#define FPF_memcpy(dst, src, num) memcpy(dst, src, num)
+#endif
+
+// #define your own FPF_memchr() to override the include of memory.h for the default memchr().
+#ifndef FPF_memchr
+#include <memory.h> // For memchr().
+#define FPF_memchr(ptr, value, num) memchr(ptr, value, num)
+#endif
+
+// #define FPF_NO_SIMD to keep the library to plain C, even when the target supports SSE2.
+#if !defined(FPF_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define FPF_SSE2
+#include <emmintrin.h> // For streaming stores.
+#endif
+#if !defined(FPF_NO_SIMD) && defined(__AVX2__)
+#define FPF_AVX2
+#include <immintrin.h>
+#endif
+
+#ifdef FPF_STATS
+fpf_stats fpf_global_stats;
+
+// Gets a copy of the library's counters.
+void fpf_get_stats(
+    fpf_stats *const p_stats    // [out] Current counters.
+    )
+{
+    FPF_assert(NULL != p_stats);
+    *p_stats = fpf_global_stats;
+}
+
+// Sets all of the library's counters back to zero (e.g. at the start of each frame).
+void fpf_reset_stats(void)
+{
+    FPF_memset(&fpf_global_stats, 0, sizeof(fpf_global_stats));
+}
+#endif
+
 // This is the 5x5 pixel font image; lightly compressed.
 const unsigned char fpf_compressed_font[] =
 {
-    0, 1, 133, 20, 123, 34, 8, 16, 128, 0, 1, 133, 62, 163, 69, 16, 32, 64,
-    0, 1, 128, 20, 112, 130, 0, 1, 32, 64, 0, 2, 62, 41, 101, 0, 1, 32, 64,
-    0, 1, 128, 20, 242, 98, 128, 16, 128, 0, 8, 168, 0, 3, 39, 8, 49, 128,
-    112, 128, 0, 2, 73, 152, 72, 64, 249, 192, 28, 0, 1, 138, 136, 16, 128,
-    112, 130, 0, 1, 1, 12, 136, 32, 64, 168, 4, 0, 1, 34, 7, 28, 121, 128,
-    0, 8, 49, 194, 30, 97, 128, 0, 1, 16, 0, 1, 81, 4, 2, 146, 66, 8, 33,
-    192, 121, 142, 4, 97, 192, 0, 1, 64, 0, 1, 16, 73, 8, 144, 66, 8, 33,
-    192, 17, 134, 8, 96, 64, 16, 16, 0, 9, 65, 135, 28, 241, 239, 62, 249,
-    224, 32, 64, 162, 138, 8, 160, 130, 0, 1, 16, 134, 190, 242, 8, 188,
-    242, 96, 32, 10, 162, 138, 8, 160, 130, 32, 64, 135, 34, 241, 239, 62,
-    129, 224, 0, 8, 137, 195, 164, 130, 40, 156, 241, 192, 136, 129, 40,
-    131, 108, 162, 138, 32, 248, 129, 48, 130, 170, 162, 242, 32, 136, 137,
-    40, 130, 41, 162, 130, 64, 137, 198, 36, 242, 40, 156, 129, 160, 0, 8,
-    241, 239, 162, 138, 40, 162, 113, 192, 138, 2, 34, 138, 37, 20, 17, 0,
-    1, 241, 194, 34, 138, 162, 8, 33, 0, 1, 160, 34, 34, 82, 165, 8, 65, 0,
-    1, 147, 194, 28, 33, 72, 136, 113, 192, 0, 8, 129, 194, 0, 1, 32, 8, 0,
-    1, 16, 0, 1, 64, 69, 0, 1, 17, 206, 12, 16, 128, 32, 64, 0, 1, 2, 73,
-    16, 113, 64, 16, 64, 0, 1, 2, 73, 16, 145, 128, 9, 192, 62, 1, 174, 12,
-    112, 192, 0, 8, 16, 196, 8, 17, 2, 0, 3, 33, 68, 0, 1, 1, 2, 52, 96,
-    128, 112, 199, 8, 17, 66, 42, 81, 64, 32, 68, 136, 81, 130, 34, 81, 64,
-    33, 132, 136, 33, 66, 34, 80, 128, 0, 16, 96, 197, 12, 113, 37, 34, 81,
-    64, 81, 70, 8, 33, 37, 42, 33, 64, 96, 196, 4, 33, 37, 42, 32, 128, 64,
-    68, 12, 16, 194, 20, 81, 0, 10, 66, 16, 3, 224, 63, 128, 0, 1, 48, 130,
-    8, 82, 32, 63, 128, 0, 1, 17, 128, 12, 162, 32, 63, 128, 0, 1, 32, 130,
-    8, 2, 32, 63, 128, 0, 1, 48, 66, 16, 3, 239, 255, 128, 0, 5, 15, 255,
-    128
+    FPF_COMPRESSED_FONT_BYTES
+};
+
+// Where each row of the texture atlas starts in fpf_compressed_font, so decompression can start at
+// any row (see fpf_seek_font_decoder()): the index of the next byte to read...
+const unsigned short fpf_compressed_row_offsets[FPF_TEXTURE_HEIGHT] =
+{
+    0, 9, 18, 28, 37, 46, 48, 55, 63, 72, 81, 90, 92, 102, 110, 120,
+    128, 137, 137, 145, 154, 162, 170, 178, 180, 188, 196, 204, 212, 220, 222, 230,
+    239, 248, 257, 265, 267, 278, 287, 296, 305, 313, 315, 322, 331, 339, 347, 355,
+    357, 357, 365, 373, 381, 390, 390, 398, 407, 416, 425, 434, 437, 437, 437, 437
+};
+
+// ...and the number of bytes left in a run of zeros that carries over from the previous row.
+const unsigned char fpf_compressed_row_zero_bytes[FPF_TEXTURE_HEIGHT] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    8, 0, 0, 0, 0, 9, 1, 0, 0, 0, 0, 4, 0, 0, 0, 0
 };
 
 unsigned char *fpf_next_line(
@@ -221,17 +551,20 @@ size_t fpf_create_alpha_texture(
     size_t byte_index = 0; // For the outer loop.
     unsigned int i; // For loops.
 
+    FPF_PROFILE_BEGIN("fpf_create_alpha_texture");
     FPF_assert(NULL != p_alpha_texture);
 
     // Check the line pitch.
     if (line_pitch < FPF_TEXTURE_WIDTH) // if (line pitch is too short)
     {
+        FPF_PROFILE_END("fpf_create_alpha_texture");
         return required_bytes;
     }
 
     // Check the texture size.
     if (alpha_texture_size_in_bytes < line_pitch * FPF_TEXTURE_HEIGHT)
     {
+        FPF_PROFILE_END("fpf_create_alpha_texture");
         return required_bytes;
     }
 
@@ -291,9 +624,204 @@ size_t fpf_create_alpha_texture(
         p_dst = fpf_next_line(p_dst, line_pitch, 0, y_axis_direction);
     }
 
+    FPF_STAT_ADD(texture_bytes_written, FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT);
+    FPF_PROFILE_END("fpf_create_alpha_texture");
+    return 0;
+}
+
+// Prepares a decoder to decompress the font starting at the top row of the texture atlas.
+void fpf_init_font_decoder(
+    fpf_font_decoder *const p_decoder   // [out] Decoder state to initialize.
+    )
+{
+    FPF_assert(NULL != p_decoder);
+    p_decoder->byte_index = 0;
+    p_decoder->zero_bytes = 0;
+}
+
+// Decompresses the next row of the texture atlas as a bitmap; the most significant bit of the
+// first byte is the left-most texel. Rows past the end of the font data decompress to zeros.
+void fpf_decode_row_bits(
+    fpf_font_decoder *const p_decoder,  // [in/out] Decoder state.
+    unsigned char *const    p_row_bits  // [out]    FPF_ROW_BITS_SIZE bytes of texel bits.
+    )
+{
+    unsigned int i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_decode_row_bits");
+    FPF_assert(NULL != p_decoder);
+    FPF_assert(NULL != p_row_bits);
+
+    for (i = 0; i < FPF_ROW_BITS_SIZE; ++i)
+    {
+        unsigned char byte;
+
+        if (0 != p_decoder->zero_bytes) // if (in a run of zeros)
+        {
+            --p_decoder->zero_bytes;
+            p_row_bits[i] = 0x00;
+            continue;
+        }
+
+        if (p_decoder->byte_index >= sizeof(fpf_compressed_font)) // if (past the end of the font)
+        {
+            p_row_bits[i] = 0x00;
+            continue;
+        }
+
+        byte = fpf_compressed_font[p_decoder->byte_index++];
+
+        if (0 == byte) // if (this byte indicates a run of zeros)
+        {
+            // The next byte is the run-length in bytes; this byte is the first of the run.
+            FPF_assert(0 != fpf_compressed_font[p_decoder->byte_index]);
+            p_decoder->zero_bytes = fpf_compressed_font[p_decoder->byte_index++] - 1u;
+        }
+
+        p_row_bits[i] = byte;
+    }
+
+    FPF_PROFILE_END("fpf_decode_row_bits");
+}
+
+#ifndef FPF_SSE2
+// Alpha texels for each 4-bit pattern of texel bits.
+const unsigned char fpf_nibble_texels[16][4] =
+{
+    { 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x00, 0xff }, { 0x00, 0x00, 0xff, 0x00 }, { 0x00, 0x00, 0xff, 0xff },
+    { 0x00, 0xff, 0x00, 0x00 }, { 0x00, 0xff, 0x00, 0xff }, { 0x00, 0xff, 0xff, 0x00 }, { 0x00, 0xff, 0xff, 0xff },
+    { 0xff, 0x00, 0x00, 0x00 }, { 0xff, 0x00, 0x00, 0xff }, { 0xff, 0x00, 0xff, 0x00 }, { 0xff, 0x00, 0xff, 0xff },
+    { 0xff, 0xff, 0x00, 0x00 }, { 0xff, 0xff, 0x00, 0xff }, { 0xff, 0xff, 0xff, 0x00 }, { 0xff, 0xff, 0xff, 0xff }
+};
+#endif
+
+#ifdef FPF_SSE2
+// Expands two bytes of texel bits into sixteen alpha texels (0x00 or 0xff).
+__m128i fpf_expand_bits_sse2(const unsigned char first, const unsigned char second)
+{
+    const __m128i bit_mask = _mm_set_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i bytes = _mm_unpacklo_epi64(_mm_set1_epi8((char)first), _mm_set1_epi8((char)second));
+    return _mm_cmpeq_epi8(_mm_and_si128(bytes, bit_mask), bit_mask);
+}
+#endif
+
+// Creates the same alpha texture atlas as fpf_create_alpha_texture(), but suited to write-combined
+// memory (e.g. a mapped GPU staging buffer). Each 64-texel row is staged, then written out once.
+// With SSE2, a row that starts on a 64-byte cache line fills that whole line with non-temporal
+// (streaming) stores; any other row straddles two lines, and partial-line streaming stores are
+// the slow case, so it's written with ordinary stores. Keep the texture and its line pitch 64-byte
+// aligned to stream every row. The texture memory is never read and the trailing space of each
+// line (past the 64 texels) is never touched.
+// Returns: 0 on success, otherwise the size (in bytes) required to draw the font.
+size_t fpf_create_alpha_texture_streaming(
+    unsigned char *const        p_alpha_texture,                // [in/out] Raw alpha texture memory to create the font atlas in.
+    const size_t                alpha_texture_size_in_bytes,    // [in]     Size of the texture memory in bytes.
+    const size_t                line_pitch,                     // [in]     Line pitch of the texture memory in bytes.
+    const fpf_y_axis_direction  y_axis_direction                // [in]     Direction of the textures y-axis.
+    )
+{
+    const size_t required_bytes = FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT;
+
+    fpf_font_decoder decoder;
+    unsigned char row_bits[FPF_ROW_BITS_SIZE];
+    unsigned int y; // For loops.
+
+#ifndef FPF_SSE2
+    unsigned char row[FPF_TEXTURE_WIDTH];
+    unsigned int i; // For loops.
+#endif
+
+    FPF_PROFILE_BEGIN("fpf_create_alpha_texture_streaming");
+    FPF_assert(NULL != p_alpha_texture);
+
+    // Check the line pitch.
+    if (line_pitch < FPF_TEXTURE_WIDTH) // if (line pitch is too short)
+    {
+        FPF_PROFILE_END("fpf_create_alpha_texture_streaming");
+        return required_bytes;
+    }
+
+    // Check the texture size.
+    if (alpha_texture_size_in_bytes < line_pitch * FPF_TEXTURE_HEIGHT)
+    {
+        FPF_PROFILE_END("fpf_create_alpha_texture_streaming");
+        return required_bytes;
+    }
+
+    fpf_init_font_decoder(&decoder);
+
+    for (y = 0; y < FPF_TEXTURE_HEIGHT; ++y)
+    {
+        unsigned char *const p_dst = (FPF_RASTER_Y_AXIS == y_axis_direction) ?
+            &p_alpha_texture[y * line_pitch] : &p_alpha_texture[(FPF_TEXTURE_HEIGHT - 1 - y) * line_pitch];
+
+        fpf_decode_row_bits(&decoder, row_bits);
+
+#ifdef FPF_SSE2
+        {
+            // Stage the whole row in registers.
+            const __m128i texels0 = fpf_expand_bits_sse2(row_bits[0], row_bits[1]);
+            const __m128i texels1 = fpf_expand_bits_sse2(row_bits[2], row_bits[3]);
+            const __m128i texels2 = fpf_expand_bits_sse2(row_bits[4], row_bits[5]);
+            const __m128i texels3 = fpf_expand_bits_sse2(row_bits[6], row_bits[7]);
+
+            if (0 == ((size_t)p_dst & 63)) // if (the row is a whole cache line)
+            {
+                _mm_stream_si128((__m128i *)p_dst + 0, texels0);
+                _mm_stream_si128((__m128i *)p_dst + 1, texels1);
+                _mm_stream_si128((__m128i *)p_dst + 2, texels2);
+                _mm_stream_si128((__m128i *)p_dst + 3, texels3);
+            }
+            else
+            {
+                _mm_storeu_si128((__m128i *)p_dst + 0, texels0);
+                _mm_storeu_si128((__m128i *)p_dst + 1, texels1);
+                _mm_storeu_si128((__m128i *)p_dst + 2, texels2);
+                _mm_storeu_si128((__m128i *)p_dst + 3, texels3);
+            }
+        }
+#else
+        // Stage the whole row, then write it out in one copy.
+        for (i = 0; i < FPF_ROW_BITS_SIZE; ++i)
+        {
+            FPF_memcpy(&row[i * 8], fpf_nibble_texels[row_bits[i] >> 4], 4);
+            FPF_memcpy(&row[i * 8 + 4], fpf_nibble_texels[row_bits[i] & 0x0f], 4);
+        }
+
+        FPF_memcpy(p_dst, row, FPF_TEXTURE_WIDTH);
+#endif
+    }
+
+#ifdef FPF_SSE2
+    // Make the streaming stores visible before the caller hands the memory to the GPU.
+    _mm_sfence();
+#endif
+
+    FPF_STAT_ADD(texture_bytes_written, FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT);
+    FPF_PROFILE_END("fpf_create_alpha_texture_streaming");
     return 0;
 }
 
+// Gets the index of a character's glyph in the texture atlas (glyphs are numbered left-to-right,
+// top-to-bottom).
+unsigned int fpf_get_glyph_index(
+    const char character    // [in] Character to locate.
+    )
+{
+    const int ascii_value = (character < ' ' || character > '~') ? 127 : character;
+    return (unsigned int)(ascii_value - ' ');
+}
+
+// Gets the index of a cursor glyph in the texture atlas.
+unsigned int fpf_get_cursor_glyph_index(
+    const fpf_cursor_style cursor_style // [in] Cursor glyph style.
+    )
+{
+    return 96u +
+        ((cursor_style < FPF_UNDERLINE_CURSOR || cursor_style > FPF_VERTICAL_CURSOR) ?
+            FPF_UNDERLINE_CURSOR : cursor_style);
+}
+
 // Gets the [column, row] position of a character's glyph in the texture atlas.
 void fpf_get_glyph_position(
     const char          character,  // [in]  Character to locate.
@@ -301,15 +829,17 @@ void fpf_get_glyph_position(
     unsigned int *const y           // [out] Row of the glyph.
     )
 {
-    const int ascii_value = (character < ' ' || character > '~') ? 127 : character;
-    const int glyph_index = ascii_value - ' ';
+    const int glyph_index = (int)fpf_get_glyph_index(character);
     const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
     const int texture_row = glyph_index / glyphs_per_row;
     const int texture_column = glyph_index - (glyphs_per_row * texture_row);
+    FPF_PROFILE_BEGIN("fpf_get_glyph_position");
     FPF_assert(NULL != x);
     FPF_assert(NULL != y);
+    FPF_STAT_ADD(fallback_glyphs, (127 - ' ' == glyph_index) ? 1 : 0);
     *x = texture_column * FPF_GLYPH_WIDTH;
     *y = texture_row * FPF_GLYPH_HEIGHT;
+    FPF_PROFILE_END("fpf_get_glyph_position");
 }
 
 // Gets the texture coordinates of a character's glyph in the texture atlas.
@@ -323,6 +853,7 @@ void fpf_get_glyph_dx_texture_coordinates(
 {
     unsigned int x;
     unsigned int y;
+    FPF_PROFILE_BEGIN("fpf_get_glyph_dx_texture_coordinates");
     FPF_assert(NULL != left);
     FPF_assert(NULL != top);
     FPF_assert(NULL != right);
@@ -332,6 +863,7 @@ void fpf_get_glyph_dx_texture_coordinates(
     *top = (float)y / FPF_TEXTURE_HEIGHT;
     *right = (float)(x + FPF_GLYPH_WIDTH) / FPF_TEXTURE_WIDTH;
     *bottom = (float)(y + FPF_GLYPH_HEIGHT) / FPF_TEXTURE_HEIGHT;
+    FPF_PROFILE_END("fpf_get_glyph_dx_texture_coordinates");
 }
 
 // Gets the texture coordinates of a character's glyph in the texture atlas.
@@ -343,6 +875,7 @@ void fpf_get_glyph_gl_texture_coordinates(
     float *const    bottom      // [out] Bottom bound of the character's glyph.
     )
 {
+    FPF_PROFILE_BEGIN("fpf_get_glyph_gl_texture_coordinates");
     FPF_assert(NULL != left);
     FPF_assert(NULL != top);
     FPF_assert(NULL != right);
@@ -350,6 +883,7 @@ void fpf_get_glyph_gl_texture_coordinates(
     fpf_get_glyph_dx_texture_coordinates(character, left, top, right, bottom);
     *top = 1.0f - *top;
     *bottom = 1.0f - *bottom;
+    FPF_PROFILE_END("fpf_get_glyph_gl_texture_coordinates");
 }
 
 // Gets the [column, row] position of a cursor glyph in the texture atlas.
@@ -359,16 +893,16 @@ void fpf_get_cursor_glyph_position(
     unsigned int *const     y               // [out] Row of the glyph.
     )
 {
-    const int glyph_index = 96 +
-        ((cursor_style < FPF_UNDERLINE_CURSOR || cursor_style > FPF_VERTICAL_CURSOR) ?
-            FPF_UNDERLINE_CURSOR : cursor_style);
+    const int glyph_index = (int)fpf_get_cursor_glyph_index(cursor_style);
     const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
     const int texture_row = glyph_index / glyphs_per_row;
     const int texture_column = glyph_index - (glyphs_per_row * texture_row);
+    FPF_PROFILE_BEGIN("fpf_get_cursor_glyph_position");
     FPF_assert(NULL != x);
     FPF_assert(NULL != y);
     *x = texture_column * FPF_GLYPH_WIDTH;
     *y = texture_row * FPF_GLYPH_HEIGHT;
+    FPF_PROFILE_END("fpf_get_cursor_glyph_position");
 }
 
 // Gets the texture coordinates of a cursor glyph in the texture atlas.
@@ -382,6 +916,7 @@ void fpf_get_cursor_glyph_dx_texture_coordinates(
 {
     unsigned int x;
     unsigned int y;
+    FPF_PROFILE_BEGIN("fpf_get_cursor_glyph_dx_texture_coordinates");
     FPF_assert(NULL != left);
     FPF_assert(NULL != top);
     FPF_assert(NULL != right);
@@ -391,6 +926,7 @@ void fpf_get_cursor_glyph_dx_texture_coordinates(
     *top = (float)y / FPF_TEXTURE_HEIGHT;
     *right = (float)(x + FPF_GLYPH_WIDTH) / FPF_TEXTURE_WIDTH;
     *bottom = (float)(y + FPF_GLYPH_HEIGHT) / FPF_TEXTURE_HEIGHT;
+    FPF_PROFILE_END("fpf_get_cursor_glyph_dx_texture_coordinates");
 }
 
 // Gets the texture coordinates of a cursor glyph in the texture atlas.
@@ -402,6 +938,7 @@ void fpf_get_cursor_glyph_gl_texture_coordinates(
     float *const            bottom          // [out] Bottom bound of the character's glyph.
     )
 {
+    FPF_PROFILE_BEGIN("fpf_get_cursor_glyph_gl_texture_coordinates");
     FPF_assert(NULL != left);
     FPF_assert(NULL != top);
     FPF_assert(NULL != right);
@@ -409,6 +946,2483 @@ void fpf_get_cursor_glyph_gl_texture_coordinates(
     fpf_get_cursor_glyph_dx_texture_coordinates(cursor_style, left, top, right, bottom);
     *top = 1.0f - *top;
     *bottom = 1.0f - *bottom;
+    FPF_PROFILE_END("fpf_get_cursor_glyph_gl_texture_coordinates");
+}
+
+// Writes a quad as two triangles (FPF_VERTICES_PER_GLYPH vertices).
+void fpf_emit_quad(
+    fpf_vertex *const   p_quad, // [out] Where to write the quad's vertices.
+    const float         x0,     // [in]  Left edge in pixels.
+    const float         y0,     // [in]  Top edge in pixels.
+    const float         x1,     // [in]  Right edge in pixels.
+    const float         y1,     // [in]  Bottom edge in pixels.
+    const float         u0,     // [in]  Texture coordinate of the left edge.
+    const float         v0,     // [in]  Texture coordinate of the top edge.
+    const float         u1,     // [in]  Texture coordinate of the right edge.
+    const float         v1,     // [in]  Texture coordinate of the bottom edge.
+    const unsigned int  color   // [in]  Color stored in every vertex.
+    )
+{
+    FPF_assert(NULL != p_quad);
+    p_quad[0].x = x0;   p_quad[0].y = y0;   p_quad[0].u = u0;   p_quad[0].v = v0;
+    p_quad[1].x = x1;   p_quad[1].y = y0;   p_quad[1].u = u1;   p_quad[1].v = v0;
+    p_quad[2].x = x0;   p_quad[2].y = y1;   p_quad[2].u = u0;   p_quad[2].v = v1;
+    p_quad[5].x = x1;   p_quad[5].y = y1;   p_quad[5].u = u1;   p_quad[5].v = v1;
+    p_quad[0].color = color;
+    p_quad[1].color = color;
+    p_quad[2].color = color;
+    p_quad[5].color = color;
+    p_quad[3] = p_quad[2];
+    p_quad[4] = p_quad[1];
+}
+
+// Lays out a line of text as glyph quads (FPF_VERTICES_PER_GLYPH vertices each) in pixel
+// coordinates, starting with the top-left corner of the first character cell at [x, y]. A
+// newline starts the next line of text at x, FPF_GLYPH_HEIGHT pixels down. Spaces and tabs
+// advance the pen but don't emit a quad; other control characters draw the fallback glyph. Layout
+// stops early if the vertex buffer fills.
+// Returns: the number of vertices written.
+size_t fpf_layout_text(
+    const char *const           text,               // [in]  Text to lay out.
+    const size_t                length,             // [in]  Number of characters in the text.
+    const float                 x,                  // [in]  Left edge of the text in pixels.
+    const float                 y,                  // [in]  Top edge of the text in pixels.
+    const unsigned int          color,              // [in]  Color stored in every vertex.
+    const fpf_y_axis_direction  y_axis_direction,   // [in]  Direction of the texture's y-axis (picks DX or GL texture coordinates).
+    fpf_vertex *const           p_vertices,         // [out] Vertex buffer to fill.
+    const size_t                max_vertices        // [in]  Capacity of the vertex buffer in vertices.
+    )
+{
+    float pen_x = x;
+    float pen_y = y;
+    size_t vertex_count = 0;
+    size_t i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_layout_text");
+    FPF_assert(NULL != text || 0 == length);
+    FPF_assert(NULL != p_vertices || 0 == max_vertices);
+    FPF_STAT_ADD(layout_calls, 1);
+
+    for (i = 0; i < length; ++i)
+    {
+        const char character = text[i];
+        float left;
+        float top;
+        float right;
+        float bottom;
+
+        if ('\n' == character)
+        {
+            pen_x = x;
+            pen_y += FPF_GLYPH_HEIGHT;
+            continue;
+        }
+
+        if (' ' == character || '\t' == character)
+        {
+            pen_x += FPF_GLYPH_WIDTH;
+            continue;
+        }
+
+        if (vertex_count + FPF_VERTICES_PER_GLYPH > max_vertices) // if (out of room)
+        {
+            break;
+        }
+
+        if (FPF_RASTER_Y_AXIS == y_axis_direction)
+        {
+            fpf_get_glyph_dx_texture_coordinates(character, &left, &top, &right, &bottom);
+        }
+        else
+        {
+            fpf_get_glyph_gl_texture_coordinates(character, &left, &top, &right, &bottom);
+        }
+
+        fpf_emit_quad(
+            &p_vertices[vertex_count],
+            pen_x, pen_y, pen_x + FPF_GLYPH_WIDTH, pen_y + FPF_GLYPH_HEIGHT,
+            left, top, right, bottom,
+            color);
+
+        vertex_count += FPF_VERTICES_PER_GLYPH;
+        pen_x += FPF_GLYPH_WIDTH;
+    }
+
+    FPF_STAT_ADD(glyphs_emitted, vertex_count / FPF_VERTICES_PER_GLYPH);
+    FPF_PROFILE_END("fpf_layout_text");
+    return vertex_count;
+}
+
+// Decompresses the whole texture atlas as a bitmap (one bit per texel).
+void fpf_decode_atlas_bits(
+    unsigned char p_atlas_bits[FPF_TEXTURE_HEIGHT][FPF_ROW_BITS_SIZE]  // [out] Texel bits of every row.
+    )
+{
+    fpf_font_decoder decoder;
+    unsigned int y; // For loops.
+
+    fpf_init_font_decoder(&decoder);
+
+    for (y = 0; y < FPF_TEXTURE_HEIGHT; ++y)
+    {
+        fpf_decode_row_bits(&decoder, p_atlas_bits[y]);
+    }
+}
+
+// Gets a texel from a decompressed atlas bitmap; returns 0x00 or 0xff.
+unsigned char fpf_get_atlas_texel(
+    unsigned char p_atlas_bits[FPF_TEXTURE_HEIGHT][FPF_ROW_BITS_SIZE],    // [in] Texel bits of every row.
+    const unsigned int                  x,                              // [in] Column of the texel.
+    const unsigned int                  y                               // [in] Row of the texel.
+    )
+{
+    return (p_atlas_bits[y][x >> 3] & (0x80u >> (x & 7u))) ? 0xff : 0x00;
+}
+
+// Gets a texel of a glyph from a decompressed atlas bitmap. Texels outside of the glyph's 6x6
+// cell are 0x00, so effects never pick up pixels from neighboring glyphs.
+unsigned char fpf_get_glyph_texel(
+    unsigned char p_atlas_bits[FPF_TEXTURE_HEIGHT][FPF_ROW_BITS_SIZE],    // [in] Texel bits of every row.
+    const unsigned int                  glyph_index,                    // [in] Index of the glyph.
+    const int                           x,                              // [in] Column within the glyph's cell.
+    const int                           y                               // [in] Row within the glyph's cell.
+    )
+{
+    const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
+
+    if (x < 0 || y < 0 || x >= (int)FPF_GLYPH_WIDTH || y >= (int)FPF_GLYPH_HEIGHT || glyph_index >= FPF_GLYPH_COUNT)
+    {
+        return 0x00;
+    }
+
+    return fpf_get_atlas_texel(
+        p_atlas_bits,
+        (glyph_index % glyphs_per_row) * FPF_GLYPH_WIDTH + (unsigned int)x,
+        (glyph_index / glyphs_per_row) * FPF_GLYPH_HEIGHT + (unsigned int)y);
+}
+
+// Creates a two channel (RG8) texture atlas with a 1-pixel outline around each glyph. The red
+// channel is the glyph, and the green channel is the glyph dilated by one pixel (i.e. the glyph
+// plus its outline). Glyphs are laid out in FPF_OUTLINE_GLYPH_WIDTH x FPF_OUTLINE_GLYPH_HEIGHT
+// cells; see fpf_get_glyph_outline_position().
+// Returns: 0 on success, otherwise the size (in bytes) required to draw the font.
+size_t fpf_create_outline_texture(
+    unsigned char *const        p_rg_texture,               // [in/out] Raw RG8 texture memory to create the font atlas in.
+    const size_t                rg_texture_size_in_bytes,   // [in]     Size of the texture memory in bytes.
+    const size_t                line_pitch,                 // [in]     Line pitch of the texture memory in bytes.
+    const fpf_y_axis_direction  y_axis_direction            // [in]     Direction of the textures y-axis.
+    )
+{
+    const size_t required_bytes = FPF_OUTLINE_TEXTURE_WIDTH * 2 * FPF_OUTLINE_TEXTURE_HEIGHT;
+    const unsigned int cells_per_row = FPF_OUTLINE_TEXTURE_WIDTH / FPF_OUTLINE_GLYPH_WIDTH;
+
+    unsigned char atlas_bits[FPF_TEXTURE_HEIGHT][FPF_ROW_BITS_SIZE];
+    unsigned int x; // For loops.
+    unsigned int y; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_create_outline_texture");
+    FPF_assert(NULL != p_rg_texture);
+
+    // Check the line pitch.
+    if (line_pitch < FPF_OUTLINE_TEXTURE_WIDTH * 2) // if (line pitch is too short)
+    {
+        FPF_PROFILE_END("fpf_create_outline_texture");
+        return required_bytes;
+    }
+
+    // Check the texture size.
+    if (rg_texture_size_in_bytes < line_pitch * FPF_OUTLINE_TEXTURE_HEIGHT)
+    {
+        FPF_PROFILE_END("fpf_create_outline_texture");
+        return required_bytes;
+    }
+
+    fpf_decode_atlas_bits(atlas_bits);
+
+    for (y = 0; y < FPF_OUTLINE_TEXTURE_HEIGHT; ++y)
+    {
+        unsigned char *p_dst = (FPF_RASTER_Y_AXIS == y_axis_direction) ?
+            &p_rg_texture[y * line_pitch] : &p_rg_texture[(FPF_OUTLINE_TEXTURE_HEIGHT - 1 - y) * line_pitch];
+
+        // The glyph sits one pixel in from the top-left corner of its cell.
+        const int glyph_y = (int)(y % FPF_OUTLINE_GLYPH_HEIGHT) - 1;
+
+        for (x = 0; x < FPF_OUTLINE_TEXTURE_WIDTH; ++x)
+        {
+            const unsigned int glyph_index = (y / FPF_OUTLINE_GLYPH_HEIGHT) * cells_per_row + x / FPF_OUTLINE_GLYPH_WIDTH;
+            const int glyph_x = (int)(x % FPF_OUTLINE_GLYPH_WIDTH) - 1;
+
+            unsigned char outline = 0x00;
+            int i; // For loops.
+            int j; // For loops.
+
+            for (j = -1; j <= 1; ++j)
+            {
+                for (i = -1; i <= 1; ++i)
+                {
+                    outline |= fpf_get_glyph_texel(atlas_bits, glyph_index, glyph_x + i, glyph_y + j);
+                }
+            }
+
+            *p_dst++ = fpf_get_glyph_texel(atlas_bits, glyph_index, glyph_x, glyph_y);
+            *p_dst++ = outline;
+        }
+    }
+
+    FPF_STAT_ADD(texture_bytes_written, required_bytes);
+    FPF_PROFILE_END("fpf_create_outline_texture");
+    return 0;
+}
+
+// Creates a two channel (RG8) texture atlas with a drop shadow under each glyph. The red channel is
+// the glyph, and the green channel is the glyph plus its shadow (offset one pixel right and down).
+// The shadow fits in the spare column and row of each 6x6 cell, so the atlas has the same layout
+// as fpf_create_alpha_texture() and the usual glyph position and texture coordinate functions
+// apply.
+// Returns: 0 on success, otherwise the size (in bytes) required to draw the font.
+size_t fpf_create_shadow_texture(
+    unsigned char *const        p_rg_texture,               // [in/out] Raw RG8 texture memory to create the font atlas in.
+    const size_t                rg_texture_size_in_bytes,   // [in]     Size of the texture memory in bytes.
+    const size_t                line_pitch,                 // [in]     Line pitch of the texture memory in bytes.
+    const fpf_y_axis_direction  y_axis_direction            // [in]     Direction of the textures y-axis.
+    )
+{
+    const size_t required_bytes = FPF_TEXTURE_WIDTH * 2 * FPF_TEXTURE_HEIGHT;
+    const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
+
+    unsigned char atlas_bits[FPF_TEXTURE_HEIGHT][FPF_ROW_BITS_SIZE];
+    unsigned int x; // For loops.
+    unsigned int y; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_create_shadow_texture");
+    FPF_assert(NULL != p_rg_texture);
+
+    // Check the line pitch.
+    if (line_pitch < FPF_TEXTURE_WIDTH * 2) // if (line pitch is too short)
+    {
+        FPF_PROFILE_END("fpf_create_shadow_texture");
+        return required_bytes;
+    }
+
+    // Check the texture size.
+    if (rg_texture_size_in_bytes < line_pitch * FPF_TEXTURE_HEIGHT)
+    {
+        FPF_PROFILE_END("fpf_create_shadow_texture");
+        return required_bytes;
+    }
+
+    fpf_decode_atlas_bits(atlas_bits);
+
+    for (y = 0; y < FPF_TEXTURE_HEIGHT; ++y)
+    {
+        unsigned char *p_dst = (FPF_RASTER_Y_AXIS == y_axis_direction) ?
+            &p_rg_texture[y * line_pitch] : &p_rg_texture[(FPF_TEXTURE_HEIGHT - 1 - y) * line_pitch];
+
+        const int glyph_y = (int)(y % FPF_GLYPH_HEIGHT);
+
+        for (x = 0; x < FPF_TEXTURE_WIDTH; ++x)
+        {
+            const unsigned int glyph_index = (y / FPF_GLYPH_HEIGHT) * glyphs_per_row + x / FPF_GLYPH_WIDTH;
+            const int glyph_x = (int)(x % FPF_GLYPH_WIDTH);
+
+            // Texels past the last column of cells don't belong to any glyph.
+            const unsigned char glyph = (x < glyphs_per_row * FPF_GLYPH_WIDTH) ?
+                fpf_get_glyph_texel(atlas_bits, glyph_index, glyph_x, glyph_y) : 0x00;
+            const unsigned char shadow = (x < glyphs_per_row * FPF_GLYPH_WIDTH) ?
+                fpf_get_glyph_texel(atlas_bits, glyph_index, glyph_x - 1, glyph_y - 1) : 0x00;
+
+            *p_dst++ = glyph;
+            *p_dst++ = glyph | shadow;
+        }
+    }
+
+    FPF_STAT_ADD(texture_bytes_written, required_bytes);
+    FPF_PROFILE_END("fpf_create_shadow_texture");
+    return 0;
+}
+
+// Gets the [column, row] position of a glyph's cell in the outline texture atlas.
+void fpf_get_outline_cell_position(
+    const unsigned int  glyph_index,    // [in]  Index of the glyph.
+    unsigned int *const x,              // [out] Column of the cell.
+    unsigned int *const y               // [out] Row of the cell.
+    )
+{
+    const unsigned int cells_per_row = FPF_OUTLINE_TEXTURE_WIDTH / FPF_OUTLINE_GLYPH_WIDTH;
+    FPF_assert(NULL != x);
+    FPF_assert(NULL != y);
+    *x = (glyph_index % cells_per_row) * FPF_OUTLINE_GLYPH_WIDTH;
+    *y = (glyph_index / cells_per_row) * FPF_OUTLINE_GLYPH_HEIGHT;
+}
+
+// Gets the [column, row] position of a character's outlined glyph in the outline texture atlas.
+// The cell is 8x8 with the glyph one pixel in from its top-left corner; draw it one pixel up and
+// left of where the plain 6x6 glyph would go.
+void fpf_get_glyph_outline_position(
+    const char          character,  // [in]  Character to locate.
+    unsigned int *const x,          // [out] Column of the glyph.
+    unsigned int *const y           // [out] Row of the glyph.
+    )
+{
+    FPF_PROFILE_BEGIN("fpf_get_glyph_outline_position");
+    fpf_get_outline_cell_position(fpf_get_glyph_index(character), x, y);
+    FPF_PROFILE_END("fpf_get_glyph_outline_position");
+}
+
+// Gets the texture coordinates of a character's outlined glyph in the outline texture atlas.
+void fpf_get_glyph_outline_dx_texture_coordinates(
+    const char      character,  // [in]  Character to locate.
+    float *const    left,       // [out] Left bound of the character's glyph.
+    float *const    top,        // [out] Top bound of the character's glyph.
+    float *const    right,      // [out] Right bound of the character's glyph.
+    float *const    bottom      // [out] Bottom bound of the character's glyph.
+    )
+{
+    unsigned int x;
+    unsigned int y;
+    FPF_PROFILE_BEGIN("fpf_get_glyph_outline_dx_texture_coordinates");
+    FPF_assert(NULL != left);
+    FPF_assert(NULL != top);
+    FPF_assert(NULL != right);
+    FPF_assert(NULL != bottom);
+    fpf_get_glyph_outline_position(character, &x, &y);
+    *left = (float)x / FPF_OUTLINE_TEXTURE_WIDTH;
+    *top = (float)y / FPF_OUTLINE_TEXTURE_HEIGHT;
+    *right = (float)(x + FPF_OUTLINE_GLYPH_WIDTH) / FPF_OUTLINE_TEXTURE_WIDTH;
+    *bottom = (float)(y + FPF_OUTLINE_GLYPH_HEIGHT) / FPF_OUTLINE_TEXTURE_HEIGHT;
+    FPF_PROFILE_END("fpf_get_glyph_outline_dx_texture_coordinates");
+}
+
+// Gets the texture coordinates of a character's outlined glyph in the outline texture atlas.
+void fpf_get_glyph_outline_gl_texture_coordinates(
+    const char      character,  // [in]  Character to locate.
+    float *const    left,       // [out] Left bound of the character's glyph.
+    float *const    top,        // [out] Top bound of the character's glyph.
+    float *const    right,      // [out] Right bound of the character's glyph.
+    float *const    bottom      // [out] Bottom bound of the character's glyph.
+    )
+{
+    FPF_PROFILE_BEGIN("fpf_get_glyph_outline_gl_texture_coordinates");
+    FPF_assert(NULL != left);
+    FPF_assert(NULL != top);
+    FPF_assert(NULL != right);
+    FPF_assert(NULL != bottom);
+    fpf_get_glyph_outline_dx_texture_coordinates(character, left, top, right, bottom);
+    *top = 1.0f - *top;
+    *bottom = 1.0f - *bottom;
+    FPF_PROFILE_END("fpf_get_glyph_outline_gl_texture_coordinates");
+}
+
+// Gets the [column, row] position of an outlined cursor glyph in the outline texture atlas.
+void fpf_get_cursor_glyph_outline_position(
+    const fpf_cursor_style  cursor_style,   // [in]  Cursor glyph style.
+    unsigned int *const     x,              // [out] Column of the glyph.
+    unsigned int *const     y               // [out] Row of the glyph.
+    )
+{
+    FPF_PROFILE_BEGIN("fpf_get_cursor_glyph_outline_position");
+    fpf_get_outline_cell_position(fpf_get_cursor_glyph_index(cursor_style), x, y);
+    FPF_PROFILE_END("fpf_get_cursor_glyph_outline_position");
+}
+
+// Gets the texture coordinates of an outlined cursor glyph in the outline texture atlas.
+void fpf_get_cursor_glyph_outline_dx_texture_coordinates(
+    const fpf_cursor_style  cursor_style,   // [in]  Cursor glyph style.
+    float *const            left,           // [out] Left bound of the character's glyph.
+    float *const            top,            // [out] Top bound of the character's glyph.
+    float *const            right,          // [out] Right bound of the character's glyph.
+    float *const            bottom          // [out] Bottom bound of the character's glyph.
+    )
+{
+    unsigned int x;
+    unsigned int y;
+    FPF_PROFILE_BEGIN("fpf_get_cursor_glyph_outline_dx_texture_coordinates");
+    FPF_assert(NULL != left);
+    FPF_assert(NULL != top);
+    FPF_assert(NULL != right);
+    FPF_assert(NULL != bottom);
+    fpf_get_cursor_glyph_outline_position(cursor_style, &x, &y);
+    *left = (float)x / FPF_OUTLINE_TEXTURE_WIDTH;
+    *top = (float)y / FPF_OUTLINE_TEXTURE_HEIGHT;
+    *right = (float)(x + FPF_OUTLINE_GLYPH_WIDTH) / FPF_OUTLINE_TEXTURE_WIDTH;
+    *bottom = (float)(y + FPF_OUTLINE_GLYPH_HEIGHT) / FPF_OUTLINE_TEXTURE_HEIGHT;
+    FPF_PROFILE_END("fpf_get_cursor_glyph_outline_dx_texture_coordinates");
+}
+
+// Gets the texture coordinates of an outlined cursor glyph in the outline texture atlas.
+void fpf_get_cursor_glyph_outline_gl_texture_coordinates(
+    const fpf_cursor_style  cursor_style,   // [in]  Cursor glyph style.
+    float *const            left,           // [out] Left bound of the character's glyph.
+    float *const            top,            // [out] Top bound of the character's glyph.
+    float *const            right,          // [out] Right bound of the character's glyph.
+    float *const            bottom          // [out] Bottom bound of the character's glyph.
+    )
+{
+    FPF_PROFILE_BEGIN("fpf_get_cursor_glyph_outline_gl_texture_coordinates");
+    FPF_assert(NULL != left);
+    FPF_assert(NULL != top);
+    FPF_assert(NULL != right);
+    FPF_assert(NULL != bottom);
+    fpf_get_cursor_glyph_outline_dx_texture_coordinates(cursor_style, left, top, right, bottom);
+    *top = 1.0f - *top;
+    *bottom = 1.0f - *bottom;
+    FPF_PROFILE_END("fpf_get_cursor_glyph_outline_gl_texture_coordinates");
+}
+
+// Gets the FPF_GLYPH_WIDTH texels of a glyph's row out of a decompressed atlas row, lined up at the
+// top of a byte (left-most texel in the most significant bit).
+unsigned char fpf_get_glyph_row_bits(
+    const unsigned char *const  p_row_bits, // [in] FPF_ROW_BITS_SIZE bytes of texel bits.
+    const unsigned int          x           // [in] Column of the glyph's left edge.
+    )
+{
+    // Grab the 16 bits that hold the glyph's row, then shift the row to the top.
+    const unsigned int bits = (p_row_bits[x >> 3] << 8) |
+        (((x >> 3) + 1 < FPF_ROW_BITS_SIZE) ? p_row_bits[(x >> 3) + 1] : 0);
+    return (unsigned char)(((bits << (x & 7u)) >> 8) & 0xfc);
+}
+
+// Decompresses the font into a table of glyph bits for software rendering; FPF_GLYPH_HEIGHT bytes
+// per glyph (in glyph index order), one byte per row, left-most pixel in the most significant bit.
+void fpf_create_glyph_bits(
+    unsigned char *const p_glyph_bits   // [out] FPF_GLYPH_BITS_SIZE bytes of glyph bits.
+    )
+{
+    const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
+
+    unsigned char atlas_bits[FPF_TEXTURE_HEIGHT][FPF_ROW_BITS_SIZE];
+    unsigned int glyph_index; // For loops.
+    unsigned int row; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_create_glyph_bits");
+    FPF_assert(NULL != p_glyph_bits);
+
+    fpf_decode_atlas_bits(atlas_bits);
+
+    for (glyph_index = 0; glyph_index < FPF_GLYPH_COUNT; ++glyph_index)
+    {
+        const unsigned int x = (glyph_index % glyphs_per_row) * FPF_GLYPH_WIDTH;
+        const unsigned int y = (glyph_index / glyphs_per_row) * FPF_GLYPH_HEIGHT;
+
+        for (row = 0; row < FPF_GLYPH_HEIGHT; ++row)
+        {
+            p_glyph_bits[glyph_index * FPF_GLYPH_HEIGHT + row] = fpf_get_glyph_row_bits(atlas_bits[y + row], x);
+        }
+    }
+
+    FPF_PROFILE_END("fpf_create_glyph_bits");
+}
+
+// Draws text into an 8-bit (alpha or grayscale) surface in software, starting with the top-left
+// corner of the first character cell at [x, y]. Glyph pixels are set to alpha; the rest of each
+// cell is left untouched. Text is clipped to the surface. A newline starts the next line of text.
+// Returns: the number of glyphs drawn (at least partly on the surface).
+size_t fpf_draw_text_alpha8(
+    const unsigned char *const  p_glyph_bits,   // [in]     Glyph bits from fpf_create_glyph_bits().
+    unsigned char *const        p_surface,      // [in/out] Surface to draw on; first byte is the top-left pixel.
+    const unsigned int          width,          // [in]     Width of the surface in pixels.
+    const unsigned int          height,         // [in]     Height of the surface in pixels.
+    const size_t                line_pitch,     // [in]     Line pitch of the surface in bytes.
+    const int                   x,              // [in]     Left edge of the text in pixels.
+    const int                   y,              // [in]     Top edge of the text in pixels.
+    const char *const           text,           // [in]     Text to draw.
+    const size_t                length,         // [in]     Number of characters in the text.
+    const unsigned char         alpha           // [in]     Value written for glyph pixels.
+    )
+{
+    size_t glyph_count;
+    FPF_PROFILE_BEGIN("fpf_draw_text_alpha8");
+    glyph_count = fpf_draw_text_alpha8_clipped(p_glyph_bits, p_surface, width, height, line_pitch, x, y, text, length,
+                                               alpha, NULL, NULL);
+    FPF_PROFILE_END("fpf_draw_text_alpha8");
+    return glyph_count;
+}
+
+// Moves a decoder to the start of any row of the texture atlas, without decompressing the rows
+// before it.
+void fpf_seek_font_decoder(
+    fpf_font_decoder *const p_decoder,  // [out] Decoder state.
+    const unsigned int      row         // [in]  Row of the texture atlas to decompress next.
+    )
+{
+    FPF_assert(NULL != p_decoder);
+    FPF_assert(row < FPF_TEXTURE_HEIGHT);
+    p_decoder->byte_index = fpf_compressed_row_offsets[row];
+    p_decoder->zero_bytes = fpf_compressed_row_zero_bytes[row];
+}
+
+// Renders a single scanline of a row of text straight from the compressed font; no texture atlas
+// or glyph table is needed, so it suits display controllers fed one line at a time. Each
+// character is FPF_GLYPH_WIDTH pixels wide, so the line is length * FPF_GLYPH_WIDTH pixels.
+// Only the atlas row under each character is decompressed (and reused while consecutive
+// characters share it), so the state is a handful of bytes.
+// Returns: 0 on success, otherwise the size (in bytes) required for the line.
+size_t fpf_render_text_scanline(
+    const char *const       text,               // [in]  Row of text to render.
+    const size_t            length,             // [in]  Number of characters in the text.
+    const unsigned int      scanline,           // [in]  Scanline within the character cells (0 to FPF_GLYPH_HEIGHT - 1).
+    const fpf_pixel_format  pixel_format,       // [in]  Pixel format of the line.
+    const unsigned int      foreground,         // [in]  Pixel value of glyph pixels (ignored for FPF_1BPP).
+    const unsigned int      background,         // [in]  Pixel value of the other pixels (ignored for FPF_1BPP).
+    void *const             p_line,             // [out] Line of pixels.
+    const size_t            line_size_in_bytes  // [in]  Size of the line in bytes.
+    )
+{
+    const size_t pixel_count = length * FPF_GLYPH_WIDTH;
+    const size_t required_bytes =
+        (FPF_1BPP == pixel_format) ? (pixel_count + 7) / 8 :
+        (FPF_8BPP == pixel_format) ? pixel_count : pixel_count * sizeof(unsigned short);
+    const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
+
+    fpf_font_decoder decoder;
+    unsigned char row_bits[FPF_ROW_BITS_SIZE];
+    unsigned int decoded_row = FPF_TEXTURE_HEIGHT; // Atlas row in row_bits (none yet).
+    size_t pixel = 0;
+    size_t i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_render_text_scanline");
+    FPF_assert(NULL != text || 0 == length);
+    FPF_assert(NULL != p_line);
+    FPF_assert(scanline < FPF_GLYPH_HEIGHT);
+
+    if (line_size_in_bytes < required_bytes)
+    {
+        FPF_PROFILE_END("fpf_render_text_scanline");
+        return required_bytes;
+    }
+
+    if (FPF_1BPP == pixel_format)
+    {
+        FPF_memset(p_line, 0x00, required_bytes);
+    }
+
+    for (i = 0; i < length; ++i)
+    {
+        const unsigned int glyph_index = fpf_get_glyph_index(text[i]);
+        const unsigned int atlas_row = (glyph_index / glyphs_per_row) * FPF_GLYPH_HEIGHT + scanline;
+        const unsigned int atlas_x = (glyph_index % glyphs_per_row) * FPF_GLYPH_WIDTH;
+        unsigned int bits;
+        unsigned int column; // For loops.
+
+        if (atlas_row != decoded_row)
+        {
+            fpf_seek_font_decoder(&decoder, atlas_row);
+            fpf_decode_row_bits(&decoder, row_bits);
+            decoded_row = atlas_row;
+        }
+
+        bits = fpf_get_glyph_row_bits(row_bits, atlas_x);
+
+        for (column = 0; column < FPF_GLYPH_WIDTH; ++column, ++pixel, bits <<= 1)
+        {
+            const int on = (0 != (bits & 0x80));
+
+            switch (pixel_format)
+            {
+            case FPF_1BPP:
+                if (on)
+                {
+                    ((unsigned char *)p_line)[pixel >> 3] |= (unsigned char)(0x80u >> (pixel & 7u));
+                }
+                break;
+            case FPF_8BPP:
+                ((unsigned char *)p_line)[pixel] = (unsigned char)(on ? foreground : background);
+                break;
+            default:
+                ((unsigned short *)p_line)[pixel] = (unsigned short)(on ? foreground : background);
+                break;
+            }
+        }
+    }
+
+    FPF_PROFILE_END("fpf_render_text_scanline");
+    return 0;
+}
+
+// Writes the 6x6 cells of the chosen glyphs into a texture, decompressing only the atlas rows that
+// hold them (the seek index skips the rest of the font data). Texels outside those cells are left
+// untouched.
+// Returns: the number of texels written.
+size_t fpf_write_glyph_cells(
+    const unsigned char *const  p_slots,            // [in]     Destination cell of each glyph (by glyph index), or FPF_NO_SLOT.
+    const unsigned int          cells_per_row,      // [in]     Number of glyph cells in each row of the texture.
+    const unsigned int          texture_height,     // [in]     Height of the texture in texels.
+    unsigned char *const        p_alpha_texture,    // [in/out] Raw alpha texture memory.
+    const size_t                line_pitch,         // [in]     Line pitch of the texture memory in bytes.
+    const fpf_y_axis_direction  y_axis_direction    // [in]     Direction of the textures y-axis.
+    )
+{
+    const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
+
+    fpf_font_decoder decoder;
+    unsigned char row_bits[FPF_ROW_BITS_SIZE];
+    size_t texel_count = 0;
+    unsigned int glyph_row; // For loops.
+    unsigned int scanline; // For loops.
+    unsigned int column; // For loops.
+    unsigned int i; // For loops.
+
+    for (glyph_row = 0; glyph_row * glyphs_per_row < FPF_GLYPH_COUNT; ++glyph_row)
+    {
+        const unsigned int first_glyph = glyph_row * glyphs_per_row;
+        const unsigned int last_glyph = (first_glyph + glyphs_per_row < FPF_GLYPH_COUNT) ?
+            first_glyph + glyphs_per_row : FPF_GLYPH_COUNT;
+        unsigned int needed = 0;
+
+        for (i = first_glyph; i < last_glyph; ++i)
+        {
+            needed |= (FPF_NO_SLOT != p_slots[i]);
+        }
+
+        if (!needed) // if (no glyphs wanted from this row)
+        {
+            continue;
+        }
+
+        fpf_seek_font_decoder(&decoder, glyph_row * FPF_GLYPH_HEIGHT);
+
+        for (scanline = 0; scanline < FPF_GLYPH_HEIGHT; ++scanline)
+        {
+            fpf_decode_row_bits(&decoder, row_bits);
+
+            for (i = first_glyph; i < last_glyph; ++i)
+            {
+                const unsigned int slot = p_slots[i];
+                unsigned int y;
+                unsigned char *p_dst;
+                unsigned int bits;
+
+                if (FPF_NO_SLOT == slot)
+                {
+                    continue;
+                }
+
+                y = (slot / cells_per_row) * FPF_GLYPH_HEIGHT + scanline;
+                p_dst = (FPF_RASTER_Y_AXIS == y_axis_direction) ?
+                    &p_alpha_texture[y * line_pitch] : &p_alpha_texture[(texture_height - 1 - y) * line_pitch];
+                p_dst += (slot % cells_per_row) * FPF_GLYPH_WIDTH;
+
+                bits = fpf_get_glyph_row_bits(row_bits, (i - first_glyph) * FPF_GLYPH_WIDTH);
+
+                for (column = 0; column < FPF_GLYPH_WIDTH; ++column, bits <<= 1)
+                {
+                    *p_dst++ = (bits & 0x80) ? 0xff : 0x00;
+                }
+
+                texel_count += FPF_GLYPH_WIDTH;
+            }
+        }
+    }
+
+    return texel_count;
+}
+
+// Marks the glyphs of a set of characters (plus the fallback glyph) as needed.
+void fpf_mark_needed_glyphs(
+    const char *const       characters, // [in]  Characters that will be drawn.
+    const size_t            length,     // [in]  Number of characters.
+    unsigned char *const    p_needed    // [out] FPF_GLYPH_COUNT flags, by glyph index.
+    )
+{
+    size_t i; // For loops.
+
+    FPF_memset(p_needed, 0, FPF_GLYPH_COUNT);
+    p_needed[fpf_get_glyph_index('\x7f')] = 1;
+
+    for (i = 0; i < length; ++i)
+    {
+        p_needed[fpf_get_glyph_index(characters[i])] = 1;
+    }
+}
+
+// Creates the texture atlas (same layout as fpf_create_alpha_texture()) with just the glyphs for a
+// set of characters (plus the fallback glyph). Only the rows of the font holding those glyphs are
+// decompressed, and only their cells are written; the rest of the texture is left untouched. The
+// usual glyph position and texture coordinate functions apply.
+// Returns: 0 on success, otherwise the size (in bytes) required to draw the font.
+size_t fpf_create_partial_alpha_texture(
+    unsigned char *const        p_alpha_texture,                // [in/out] Raw alpha texture memory to create the font atlas in.
+    const size_t                alpha_texture_size_in_bytes,    // [in]     Size of the texture memory in bytes.
+    const size_t                line_pitch,                     // [in]     Line pitch of the texture memory in bytes.
+    const fpf_y_axis_direction  y_axis_direction,               // [in]     Direction of the textures y-axis.
+    const char *const           characters,                     // [in]     Characters that will be drawn (a string works).
+    const size_t                length                          // [in]     Number of characters.
+    )
+{
+    const size_t required_bytes = FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT;
+
+    unsigned char slots[FPF_GLYPH_COUNT];
+    size_t texel_count;
+    unsigned int i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_create_partial_alpha_texture");
+    FPF_assert(NULL != p_alpha_texture);
+    FPF_assert(NULL != characters || 0 == length);
+
+    // Check the line pitch.
+    if (line_pitch < FPF_TEXTURE_WIDTH) // if (line pitch is too short)
+    {
+        FPF_PROFILE_END("fpf_create_partial_alpha_texture");
+        return required_bytes;
+    }
+
+    // Check the texture size.
+    if (alpha_texture_size_in_bytes < line_pitch * FPF_TEXTURE_HEIGHT)
+    {
+        FPF_PROFILE_END("fpf_create_partial_alpha_texture");
+        return required_bytes;
+    }
+
+    // Each glyph goes in its usual cell.
+    fpf_mark_needed_glyphs(characters, length, slots);
+    for (i = 0; i < FPF_GLYPH_COUNT; ++i)
+    {
+        slots[i] = slots[i] ? (unsigned char)i : (unsigned char)FPF_NO_SLOT;
+    }
+
+    texel_count = fpf_write_glyph_cells(slots, FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH, FPF_TEXTURE_HEIGHT,
+                                        p_alpha_texture, line_pitch, y_axis_direction);
+
+    FPF_STAT_ADD(texture_bytes_written, texel_count);
+    FPF_PROFILE_END("fpf_create_partial_alpha_texture");
+    return 0;
+}
+
+// Plans a packed texture atlas holding just the glyphs for a set of characters (plus the fallback
+// glyph, which any other character maps to). The glyphs are packed into a roughly square grid of
+// 6x6 cells; p_atlas->width and p_atlas->height give the size of the texture to create (they're
+// not powers of two).
+void fpf_plan_packed_atlas(
+    fpf_packed_atlas *const p_atlas,    // [out] Layout of the packed atlas.
+    const char *const       characters, // [in]  Characters that will be drawn (a string works).
+    const size_t            length      // [in]  Number of characters.
+    )
+{
+    unsigned char needed[FPF_GLYPH_COUNT];
+    unsigned int rows;
+    unsigned int i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_plan_packed_atlas");
+    FPF_assert(NULL != p_atlas);
+    FPF_assert(NULL != characters || 0 == length);
+
+    fpf_mark_needed_glyphs(characters, length, needed);
+
+    p_atlas->glyph_count = 0;
+    for (i = 0; i < FPF_GLYPH_COUNT; ++i)
+    {
+        p_atlas->slots[i] = needed[i] ? (unsigned char)p_atlas->glyph_count++ : (unsigned char)FPF_NO_SLOT;
+    }
+
+    // Smallest square number of cells per row that fits every glyph.
+    p_atlas->cells_per_row = 1;
+    while (p_atlas->cells_per_row * p_atlas->cells_per_row < p_atlas->glyph_count)
+    {
+        ++p_atlas->cells_per_row;
+    }
+
+    rows = (p_atlas->glyph_count + p_atlas->cells_per_row - 1) / p_atlas->cells_per_row;
+    p_atlas->width = p_atlas->cells_per_row * FPF_GLYPH_WIDTH;
+    p_atlas->height = rows * FPF_GLYPH_HEIGHT;
+    FPF_PROFILE_END("fpf_plan_packed_atlas");
+}
+
+// Creates a packed texture atlas planned by fpf_plan_packed_atlas(). Only the rows of the font
+// holding the packed glyphs are decompressed. Cells past the last glyph are left untouched.
+// Returns: 0 on success, otherwise the size (in bytes) required to draw the packed atlas.
+size_t fpf_create_packed_alpha_texture(
+    const fpf_packed_atlas *const   p_atlas,                        // [in]     Layout of the packed atlas.
+    unsigned char *const            p_alpha_texture,                // [in/out] Raw alpha texture memory to create the atlas in.
+    const size_t                    alpha_texture_size_in_bytes,    // [in]     Size of the texture memory in bytes.
+    const size_t                    line_pitch,                     // [in]     Line pitch of the texture memory in bytes.
+    const fpf_y_axis_direction      y_axis_direction                // [in]     Direction of the textures y-axis.
+    )
+{
+    size_t texel_count;
+
+    FPF_PROFILE_BEGIN("fpf_create_packed_alpha_texture");
+    FPF_assert(NULL != p_atlas);
+    FPF_assert(NULL != p_alpha_texture);
+
+    // Check the line pitch and the texture size.
+    if (line_pitch < p_atlas->width || alpha_texture_size_in_bytes < line_pitch * p_atlas->height)
+    {
+        FPF_PROFILE_END("fpf_create_packed_alpha_texture");
+        return (size_t)p_atlas->width * p_atlas->height;
+    }
+
+    texel_count = fpf_write_glyph_cells(p_atlas->slots, p_atlas->cells_per_row, p_atlas->height,
+                                        p_alpha_texture, line_pitch, y_axis_direction);
+
+    FPF_STAT_ADD(texture_bytes_written, texel_count);
+    FPF_PROFILE_END("fpf_create_packed_alpha_texture");
+    return 0;
+}
+
+// Gets the [column, row] position of a character's glyph in a packed texture atlas. Characters
+// that weren't packed get the fallback glyph.
+void fpf_get_packed_glyph_position(
+    const fpf_packed_atlas *const   p_atlas,    // [in]  Layout of the packed atlas.
+    const char                      character,  // [in]  Character to locate.
+    unsigned int *const             x,          // [out] Column of the glyph.
+    unsigned int *const             y           // [out] Row of the glyph.
+    )
+{
+    unsigned int slot;
+    FPF_PROFILE_BEGIN("fpf_get_packed_glyph_position");
+    FPF_assert(NULL != p_atlas);
+    FPF_assert(NULL != x);
+    FPF_assert(NULL != y);
+    slot = p_atlas->slots[fpf_get_glyph_index(character)];
+    if (FPF_NO_SLOT == slot)
+    {
+        FPF_STAT_ADD(fallback_glyphs, 1);
+        slot = p_atlas->slots[fpf_get_glyph_index('\x7f')];
+    }
+    *x = (slot % p_atlas->cells_per_row) * FPF_GLYPH_WIDTH;
+    *y = (slot / p_atlas->cells_per_row) * FPF_GLYPH_HEIGHT;
+    FPF_PROFILE_END("fpf_get_packed_glyph_position");
+}
+
+// Gets the texture coordinates of a character's glyph in a packed texture atlas.
+void fpf_get_packed_glyph_dx_texture_coordinates(
+    const fpf_packed_atlas *const   p_atlas,    // [in]  Layout of the packed atlas.
+    const char                      character,  // [in]  Character to locate.
+    float *const                    left,       // [out] Left bound of the character's glyph.
+    float *const                    top,        // [out] Top bound of the character's glyph.
+    float *const                    right,      // [out] Right bound of the character's glyph.
+    float *const                    bottom      // [out] Bottom bound of the character's glyph.
+    )
+{
+    unsigned int x;
+    unsigned int y;
+    FPF_PROFILE_BEGIN("fpf_get_packed_glyph_dx_texture_coordinates");
+    FPF_assert(NULL != left);
+    FPF_assert(NULL != top);
+    FPF_assert(NULL != right);
+    FPF_assert(NULL != bottom);
+    fpf_get_packed_glyph_position(p_atlas, character, &x, &y);
+    *left = (float)x / p_atlas->width;
+    *top = (float)y / p_atlas->height;
+    *right = (float)(x + FPF_GLYPH_WIDTH) / p_atlas->width;
+    *bottom = (float)(y + FPF_GLYPH_HEIGHT) / p_atlas->height;
+    FPF_PROFILE_END("fpf_get_packed_glyph_dx_texture_coordinates");
+}
+
+// Gets the texture coordinates of a character's glyph in a packed texture atlas.
+void fpf_get_packed_glyph_gl_texture_coordinates(
+    const fpf_packed_atlas *const   p_atlas,    // [in]  Layout of the packed atlas.
+    const char                      character,  // [in]  Character to locate.
+    float *const                    left,       // [out] Left bound of the character's glyph.
+    float *const                    top,        // [out] Top bound of the character's glyph.
+    float *const                    right,      // [out] Right bound of the character's glyph.
+    float *const                    bottom      // [out] Bottom bound of the character's glyph.
+    )
+{
+    FPF_PROFILE_BEGIN("fpf_get_packed_glyph_gl_texture_coordinates");
+    FPF_assert(NULL != left);
+    FPF_assert(NULL != top);
+    FPF_assert(NULL != right);
+    FPF_assert(NULL != bottom);
+    fpf_get_packed_glyph_dx_texture_coordinates(p_atlas, character, left, top, right, bottom);
+    *top = 1.0f - *top;
+    *bottom = 1.0f - *bottom;
+    FPF_PROFILE_END("fpf_get_packed_glyph_gl_texture_coordinates");
+}
+
+// Replacements used when no table is given: common Latin-1, punctuation, arrow, box-drawing and
+// block characters drawn with the closest existing glyph.
+const fpf_replacement fpf_default_replacements[] =
+{
+    { 0x00A0, 0x00A0, FPF_ASCII_GLYPH(' ') },   { 0x00A1, 0x00A1, FPF_ASCII_GLYPH('!') },
+    { 0x00A2, 0x00A2, FPF_ASCII_GLYPH('c') },   { 0x00A3, 0x00A3, FPF_ASCII_GLYPH('L') },
+    { 0x00A5, 0x00A5, FPF_ASCII_GLYPH('Y') },   { 0x00A6, 0x00A6, FPF_ASCII_GLYPH('|') },
+    { 0x00A9, 0x00A9, FPF_ASCII_GLYPH('C') },   { 0x00AA, 0x00AA, FPF_ASCII_GLYPH('a') },
+    { 0x00AB, 0x00AB, FPF_ASCII_GLYPH('<') },   { 0x00AC, 0x00AD, FPF_ASCII_GLYPH('-') },
+    { 0x00AE, 0x00AE, FPF_ASCII_GLYPH('R') },   { 0x00B0, 0x00B0, FPF_ASCII_GLYPH('o') },
+    { 0x00B1, 0x00B1, FPF_ASCII_GLYPH('+') },   { 0x00B2, 0x00B2, FPF_ASCII_GLYPH('2') },
+    { 0x00B3, 0x00B3, FPF_ASCII_GLYPH('3') },   { 0x00B4, 0x00B4, FPF_ASCII_GLYPH('\'') },
+    { 0x00B5, 0x00B5, FPF_ASCII_GLYPH('u') },   { 0x00B7, 0x00B7, FPF_ASCII_GLYPH('.') },
+    { 0x00B9, 0x00B9, FPF_ASCII_GLYPH('1') },   { 0x00BA, 0x00BA, FPF_ASCII_GLYPH('o') },
+    { 0x00BB, 0x00BB, FPF_ASCII_GLYPH('>') },   { 0x00BF, 0x00BF, FPF_ASCII_GLYPH('?') },
+    { 0x00C0, 0x00C6, FPF_ASCII_GLYPH('A') },   { 0x00C7, 0x00C7, FPF_ASCII_GLYPH('C') },
+    { 0x00C8, 0x00CB, FPF_ASCII_GLYPH('E') },   { 0x00CC, 0x00CF, FPF_ASCII_GLYPH('I') },
+    { 0x00D0, 0x00D0, FPF_ASCII_GLYPH('D') },   { 0x00D1, 0x00D1, FPF_ASCII_GLYPH('N') },
+    { 0x00D2, 0x00D6, FPF_ASCII_GLYPH('O') },   { 0x00D7, 0x00D7, FPF_ASCII_GLYPH('x') },
+    { 0x00D8, 0x00D8, FPF_ASCII_GLYPH('O') },   { 0x00D9, 0x00DC, FPF_ASCII_GLYPH('U') },
+    { 0x00DD, 0x00DD, FPF_ASCII_GLYPH('Y') },   { 0x00DE, 0x00DE, FPF_ASCII_GLYPH('P') },
+    { 0x00DF, 0x00DF, FPF_ASCII_GLYPH('s') },   { 0x00E0, 0x00E6, FPF_ASCII_GLYPH('a') },
+    { 0x00E7, 0x00E7, FPF_ASCII_GLYPH('c') },   { 0x00E8, 0x00EB, FPF_ASCII_GLYPH('e') },
+    { 0x00EC, 0x00EF, FPF_ASCII_GLYPH('i') },   { 0x00F0, 0x00F0, FPF_ASCII_GLYPH('d') },
+    { 0x00F1, 0x00F1, FPF_ASCII_GLYPH('n') },   { 0x00F2, 0x00F6, FPF_ASCII_GLYPH('o') },
+    { 0x00F7, 0x00F7, FPF_ASCII_GLYPH('/') },   { 0x00F8, 0x00F8, FPF_ASCII_GLYPH('o') },
+    { 0x00F9, 0x00FC, FPF_ASCII_GLYPH('u') },   { 0x00FD, 0x00FD, FPF_ASCII_GLYPH('y') },
+    { 0x00FE, 0x00FE, FPF_ASCII_GLYPH('p') },   { 0x00FF, 0x00FF, FPF_ASCII_GLYPH('y') },
+    { 0x0192, 0x0192, FPF_ASCII_GLYPH('f') },   { 0x03B1, 0x03B1, FPF_ASCII_GLYPH('a') },
+    { 0x03B5, 0x03B5, FPF_ASCII_GLYPH('e') },   { 0x03C3, 0x03C3, FPF_ASCII_GLYPH('o') },
+    { 0x03C4, 0x03C4, FPF_ASCII_GLYPH('t') },   { 0x2010, 0x2015, FPF_ASCII_GLYPH('-') },
+    { 0x2018, 0x201B, FPF_ASCII_GLYPH('\'') },  { 0x201C, 0x201F, FPF_ASCII_GLYPH('"') },
+    { 0x2022, 0x2022, FPF_ASCII_GLYPH('*') },   { 0x2026, 0x2026, FPF_ASCII_GLYPH('.') },
+    { 0x2039, 0x2039, FPF_ASCII_GLYPH('<') },   { 0x203A, 0x203A, FPF_ASCII_GLYPH('>') },
+    { 0x20AC, 0x20AC, FPF_ASCII_GLYPH('E') },   { 0x2122, 0x2122, FPF_ASCII_GLYPH('T') },
+    { 0x2190, 0x2190, FPF_ASCII_GLYPH('<') },   { 0x2191, 0x2191, FPF_ASCII_GLYPH('^') },
+    { 0x2192, 0x2192, FPF_ASCII_GLYPH('>') },   { 0x2193, 0x2193, FPF_ASCII_GLYPH('v') },
+    { 0x2212, 0x2212, FPF_ASCII_GLYPH('-') },   { 0x2219, 0x2219, FPF_ASCII_GLYPH('.') },
+    { 0x2248, 0x2248, FPF_ASCII_GLYPH('~') },   { 0x2261, 0x2261, FPF_ASCII_GLYPH('=') },
+    { 0x2264, 0x2264, FPF_ASCII_GLYPH('<') },   { 0x2265, 0x2265, FPF_ASCII_GLYPH('>') },
+    { 0x2500, 0x2501, FPF_ASCII_GLYPH('-') },   { 0x2502, 0x2503, FPF_ASCII_GLYPH('|') },
+    { 0x2504, 0x2505, FPF_ASCII_GLYPH('-') },   { 0x2506, 0x2507, FPF_ASCII_GLYPH('|') },
+    { 0x2508, 0x2509, FPF_ASCII_GLYPH('-') },   { 0x250A, 0x250B, FPF_ASCII_GLYPH('|') },
+    { 0x250C, 0x254B, FPF_ASCII_GLYPH('+') },   { 0x254C, 0x254D, FPF_ASCII_GLYPH('-') },
+    { 0x254E, 0x254F, FPF_ASCII_GLYPH('|') },   { 0x2550, 0x2550, FPF_ASCII_GLYPH('=') },
+    { 0x2551, 0x2551, FPF_ASCII_GLYPH('|') },   { 0x2552, 0x2570, FPF_ASCII_GLYPH('+') },
+    { 0x2582, 0x2584, FPF_CURSOR_GLYPH(FPF_UNDERLINE_CURSOR) },
+    { 0x2588, 0x2588, FPF_CURSOR_GLYPH(FPF_BLOCK_CURSOR) },
+    { 0x258F, 0x258F, FPF_CURSOR_GLYPH(FPF_VERTICAL_CURSOR) },
+    { 0x25A0, 0x25A0, FPF_CURSOR_GLYPH(FPF_BLOCK_CURSOR) }
+};
+
+// Unicode code points of the upper half (0x80 to 0xFF) of code page 437 (the original IBM PC
+// character set), for fpf_code_page_to_glyph_indices().
+const unsigned short fpf_cp437_code_points[128] =
+{
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7, 0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9, 0x00FF, 0x00D6, 0x00DC, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA, 0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556, 0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F, 0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B, 0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4, 0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248, 0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0
+};
+
+// Gets the glyph index for a Unicode code point: printable ASCII maps to its own glyph, a newline
+// to FPF_NEWLINE_GLYPH and a tab to a space. Anything else is looked up in a replacement table
+// (sorted by code point; NULL uses fpf_default_replacements), then falls back to the fallback glyph.
+unsigned int fpf_get_code_point_glyph_index(
+    const unsigned long             code_point,         // [in] Unicode code point.
+    const fpf_replacement *const    p_replacements,     // [in] Sorted replacement table, or NULL for the default.
+    const size_t                    replacement_count   // [in] Number of replacements in the table.
+    )
+{
+    const fpf_replacement *const p_table = (NULL != p_replacements) ? p_replacements : fpf_default_replacements;
+    size_t low = 0;
+    size_t high = (NULL != p_replacements) ? replacement_count :
+        sizeof(fpf_default_replacements) / sizeof(fpf_default_replacements[0]);
+
+    if (code_point >= ' ' && code_point <= '~')
+    {
+        return (unsigned int)(code_point - ' ');
+    }
+
+    if ('\n' == code_point)
+    {
+        return FPF_NEWLINE_GLYPH;
+    }
+
+    if ('\t' == code_point)
+    {
+        return FPF_ASCII_GLYPH(' ');
+    }
+
+    // Binary search for the range holding the code point.
+    while (low < high)
+    {
+        const size_t middle = low + (high - low) / 2;
+
+        if (code_point < p_table[middle].first)
+        {
+            high = middle;
+        }
+        else if (code_point > p_table[middle].last)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            return p_table[middle].glyph_index;
+        }
+    }
+
+    FPF_STAT_ADD(fallback_glyphs, 1);
+    return FPF_ASCII_GLYPH('\x7f');
+}
+
+// Converts a run of printable ASCII (0x20 to 0x7E) straight to glyph indices, 16 or 32 bytes at a
+// time with SSE2 or AVX2. It stops at the first block holding anything else, leaving the rest for
+// the caller's scalar path.
+// Returns: the number of bytes (and glyphs) converted.
+size_t fpf_convert_ascii_run(
+    const unsigned char *const  p_text,             // [in]  Text to convert.
+    const size_t                length,             // [in]  Number of bytes of text.
+    unsigned char *const        p_glyph_indices,    // [out] Glyph indices.
+    const size_t                max_glyphs          // [in]  Capacity of p_glyph_indices.
+    )
+{
+    const size_t limit = (length < max_glyphs) ? length : max_glyphs;
+    size_t converted = 0;
+
+#ifdef FPF_AVX2
+    {
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i below_space = _mm256_set1_epi8(' ' - 1);
+        const __m256i delete_character = _mm256_set1_epi8(0x7f);
+
+        while (converted + 32 <= limit)
+        {
+            const __m256i bytes = _mm256_loadu_si256((const __m256i *)(p_text + converted));
+
+            // Bytes of 0x80 and up are negative, so they fail the signed "greater than ' ' - 1" test.
+            const __m256i printable = _mm256_and_si256(
+                _mm256_cmpgt_epi8(bytes, below_space), _mm256_cmpgt_epi8(delete_character, bytes));
+
+            if (-1 != _mm256_movemask_epi8(printable)) // if (anything else is in the block)
+            {
+                break;
+            }
+
+            _mm256_storeu_si256((__m256i *)(p_glyph_indices + converted), _mm256_sub_epi8(bytes, space));
+            converted += 32;
+        }
+    }
+#endif
+
+#ifdef FPF_SSE2
+    {
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i below_space = _mm_set1_epi8(' ' - 1);
+        const __m128i delete_character = _mm_set1_epi8(0x7f);
+
+        while (converted + 16 <= limit)
+        {
+            const __m128i bytes = _mm_loadu_si128((const __m128i *)(p_text + converted));
+
+            // Bytes of 0x80 and up are negative, so they fail the signed "greater than ' ' - 1" test.
+            const __m128i printable = _mm_and_si128(
+                _mm_cmpgt_epi8(bytes, below_space), _mm_cmpgt_epi8(delete_character, bytes));
+
+            if (0xffff != _mm_movemask_epi8(printable)) // if (anything else is in the block)
+            {
+                break;
+            }
+
+            _mm_storeu_si128((__m128i *)(p_glyph_indices + converted), _mm_sub_epi8(bytes, space));
+            converted += 16;
+        }
+    }
+#endif
+
+    (void)p_text;
+    (void)limit;
+    (void)p_glyph_indices;
+    return converted;
+}
+
+// Converts UTF-8 text to glyph indices, one glyph per code point (see
+// fpf_get_code_point_glyph_index()). Malformed sequences get one fallback glyph per bad byte;
+// zero-width characters (byte order marks, zero-width spaces) get no glyph. Conversion stops when
+// p_glyph_indices is full, without splitting a code point.
+// Returns: the number of glyph indices written.
+size_t fpf_utf8_to_glyph_indices(
+    const char *const               text,               // [in]  UTF-8 text to convert.
+    const size_t                    length,             // [in]  Number of bytes of text.
+    const fpf_replacement *const    p_replacements,     // [in]  Sorted replacement table, or NULL for the default.
+    const size_t                    replacement_count,  // [in]  Number of replacements in the table.
+    unsigned char *const            p_glyph_indices,    // [out] Glyph indices.
+    const size_t                    max_glyphs,         // [in]  Capacity of p_glyph_indices.
+    size_t *const                   p_bytes_used        // [out] Optional; number of bytes of text converted.
+    )
+{
+    const unsigned char *const p_text = (const unsigned char *)text;
+    size_t byte_index = 0;
+    size_t glyph_count = 0;
+
+    FPF_PROFILE_BEGIN("fpf_utf8_to_glyph_indices");
+    FPF_assert(NULL != text || 0 == length);
+    FPF_assert(NULL != p_glyph_indices || 0 == max_glyphs);
+
+    while (byte_index < length && glyph_count < max_glyphs)
+    {
+        const unsigned char lead = p_text[byte_index];
+        unsigned long code_point;
+        unsigned int sequence_length;
+        unsigned int i; // For loops.
+
+        if (lead < 0x80)
+        {
+            // Take as much plain ASCII as possible in blocks, then one character at a time.
+            const size_t converted = fpf_convert_ascii_run(
+                p_text + byte_index, length - byte_index, p_glyph_indices + glyph_count, max_glyphs - glyph_count);
+
+            if (0 != converted)
+            {
+                byte_index += converted;
+                glyph_count += converted;
+                continue;
+            }
+
+            p_glyph_indices[glyph_count++] = (unsigned char)fpf_get_code_point_glyph_index(lead, p_replacements, replacement_count);
+            ++byte_index;
+            continue;
+        }
+
+        // Work out the length of the sequence and the lead byte's bits of the code point.
+        if (lead >= 0xc2 && lead <= 0xdf)
+        {
+            sequence_length = 2;
+            code_point = lead & 0x1f;
+        }
+        else if (lead >= 0xe0 && lead <= 0xef)
+        {
+            sequence_length = 3;
+            code_point = lead & 0x0f;
+        }
+        else if (lead >= 0xf0 && lead <= 0xf4)
+        {
+            sequence_length = 4;
+            code_point = lead & 0x07;
+        }
+        else // Not a lead byte.
+        {
+            sequence_length = 0;
+            code_point = 0;
+        }
+
+        for (i = 1; i < sequence_length; ++i)
+        {
+            if (byte_index + i >= length || 0x80 != (p_text[byte_index + i] & 0xc0)) // if (truncated)
+            {
+                sequence_length = 0;
+                break;
+            }
+
+            code_point = (code_point << 6) | (p_text[byte_index + i] & 0x3f);
+        }
+
+        // Reject overlong encodings, surrogates and code points past U+10FFFF.
+        if ((3 == sequence_length && code_point < 0x800) ||
+            (4 == sequence_length && (code_point < 0x10000 || code_point > 0x10ffff)) ||
+            (code_point >= 0xd800 && code_point <= 0xdfff))
+        {
+            sequence_length = 0;
+        }
+
+        if (0 == sequence_length)
+        {
+            FPF_STAT_ADD(fallback_glyphs, 1);
+            p_glyph_indices[glyph_count++] = FPF_ASCII_GLYPH('\x7f');
+            ++byte_index;
+            continue;
+        }
+
+        byte_index += sequence_length;
+
+        if (0xfeff == code_point || 0x200b == code_point) // if (zero-width)
+        {
+            continue;
+        }
+
+        p_glyph_indices[glyph_count++] = (unsigned char)fpf_get_code_point_glyph_index(code_point, p_replacements, replacement_count);
+    }
+
+    if (NULL != p_bytes_used)
+    {
+        *p_bytes_used = byte_index;
+    }
+
+    FPF_PROFILE_END("fpf_utf8_to_glyph_indices");
+    return glyph_count;
+}
+
+// Converts text in a single-byte code page to glyph indices, one glyph per byte. The lower half is
+// ASCII; p_code_points gives the Unicode code points of the upper half (0x80 to 0xFF; e.g.
+// fpf_cp437_code_points), or NULL for Latin-1 (ISO 8859-1).
+// Returns: the number of glyph indices written.
+size_t fpf_code_page_to_glyph_indices(
+    const char *const               text,               // [in]  Text to convert.
+    const size_t                    length,             // [in]  Number of bytes of text.
+    const unsigned short *const     p_code_points,      // [in]  128 code points of the upper half, or NULL for Latin-1.
+    const fpf_replacement *const    p_replacements,     // [in]  Sorted replacement table, or NULL for the default.
+    const size_t                    replacement_count,  // [in]  Number of replacements in the table.
+    unsigned char *const            p_glyph_indices,    // [out] Glyph indices.
+    const size_t                    max_glyphs          // [in]  Capacity of p_glyph_indices.
+    )
+{
+    const unsigned char *const p_text = (const unsigned char *)text;
+    const size_t limit = (length < max_glyphs) ? length : max_glyphs;
+    size_t i = 0;
+
+    FPF_PROFILE_BEGIN("fpf_code_page_to_glyph_indices");
+    FPF_assert(NULL != text || 0 == length);
+    FPF_assert(NULL != p_glyph_indices || 0 == max_glyphs);
+
+    while (i < limit)
+    {
+        const unsigned char byte = p_text[i];
+        const size_t converted = fpf_convert_ascii_run(p_text + i, limit - i, p_glyph_indices + i, limit - i);
+
+        if (0 != converted)
+        {
+            i += converted;
+            continue;
+        }
+
+        p_glyph_indices[i++] = (unsigned char)fpf_get_code_point_glyph_index(
+            (byte >= 0x80 && NULL != p_code_points) ? p_code_points[byte - 0x80] : byte,
+            p_replacements,
+            replacement_count);
+    }
+
+    FPF_PROFILE_END("fpf_code_page_to_glyph_indices");
+    return limit;
+}
+
+// Lays out a string of glyph indices (e.g. from fpf_utf8_to_glyph_indices()) as glyph quads, the
+// same way as fpf_layout_text(). The pen position carries in and out so long text can be laid
+// out in pieces.
+// Returns: the number of vertices written.
+size_t fpf_layout_glyph_run(
+    const unsigned char *const  p_glyph_indices,    // [in]     Glyph indices to lay out.
+    const size_t                count,              // [in]     Number of glyph indices.
+    const float                 x,                  // [in]     Left edge of the text in pixels (where new lines start).
+    float *const                p_pen_x,            // [in/out] Where the next glyph goes.
+    float *const                p_pen_y,            // [in/out] Where the next glyph goes.
+    const unsigned int          color,              // [in]     Color stored in every vertex.
+    const fpf_y_axis_direction  y_axis_direction,   // [in]     Direction of the texture's y-axis.
+    fpf_vertex *const           p_vertices,         // [out]    Vertex buffer to fill.
+    const size_t                max_vertices        // [in]     Capacity of the vertex buffer in vertices.
+    )
+{
+    const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
+    size_t vertex_count = 0;
+    size_t i; // For loops.
+
+    for (i = 0; i < count; ++i)
+    {
+        const unsigned int glyph_index = p_glyph_indices[i];
+        float left;
+        float top;
+        float right;
+        float bottom;
+
+        if (FPF_NEWLINE_GLYPH == glyph_index)
+        {
+            *p_pen_x = x;
+            *p_pen_y += FPF_GLYPH_HEIGHT;
+            continue;
+        }
+
+        if (FPF_ASCII_GLYPH(' ') == glyph_index || glyph_index >= FPF_GLYPH_COUNT)
+        {
+            *p_pen_x += FPF_GLYPH_WIDTH;
+            continue;
+        }
+
+        if (vertex_count + FPF_VERTICES_PER_GLYPH > max_vertices) // if (out of room)
+        {
+            break;
+        }
+
+        left = (float)((glyph_index % glyphs_per_row) * FPF_GLYPH_WIDTH) / FPF_TEXTURE_WIDTH;
+        top = (float)((glyph_index / glyphs_per_row) * FPF_GLYPH_HEIGHT) / FPF_TEXTURE_HEIGHT;
+        right = left + (float)FPF_GLYPH_WIDTH / FPF_TEXTURE_WIDTH;
+        bottom = top + (float)FPF_GLYPH_HEIGHT / FPF_TEXTURE_HEIGHT;
+
+        if (FPF_VECTOR_Y_AXIS == y_axis_direction)
+        {
+            top = 1.0f - top;
+            bottom = 1.0f - bottom;
+        }
+
+        fpf_emit_quad(
+            &p_vertices[vertex_count],
+            *p_pen_x, *p_pen_y, *p_pen_x + FPF_GLYPH_WIDTH, *p_pen_y + FPF_GLYPH_HEIGHT,
+            left, top, right, bottom,
+            color);
+
+        vertex_count += FPF_VERTICES_PER_GLYPH;
+        *p_pen_x += FPF_GLYPH_WIDTH;
+    }
+
+    FPF_STAT_ADD(glyphs_emitted, vertex_count / FPF_VERTICES_PER_GLYPH);
+    return vertex_count;
+}
+
+// Lays out a string of glyph indices (e.g. from fpf_utf8_to_glyph_indices()) as glyph quads; see
+// fpf_layout_text().
+// Returns: the number of vertices written.
+size_t fpf_layout_glyph_indices(
+    const unsigned char *const  p_glyph_indices,    // [in]  Glyph indices to lay out.
+    const size_t                count,              // [in]  Number of glyph indices.
+    const float                 x,                  // [in]  Left edge of the text in pixels.
+    const float                 y,                  // [in]  Top edge of the text in pixels.
+    const unsigned int          color,              // [in]  Color stored in every vertex.
+    const fpf_y_axis_direction  y_axis_direction,   // [in]  Direction of the texture's y-axis.
+    fpf_vertex *const           p_vertices,         // [out] Vertex buffer to fill.
+    const size_t                max_vertices        // [in]  Capacity of the vertex buffer in vertices.
+    )
+{
+    float pen_x = x;
+    float pen_y = y;
+    size_t vertex_count;
+
+    FPF_PROFILE_BEGIN("fpf_layout_glyph_indices");
+    FPF_assert(NULL != p_glyph_indices || 0 == count);
+    FPF_assert(NULL != p_vertices || 0 == max_vertices);
+    FPF_STAT_ADD(layout_calls, 1);
+
+    vertex_count = fpf_layout_glyph_run(p_glyph_indices, count, x, &pen_x, &pen_y, color, y_axis_direction,
+                                        p_vertices, max_vertices);
+
+    FPF_PROFILE_END("fpf_layout_glyph_indices");
+    return vertex_count;
+}
+
+// Lays out UTF-8 text as glyph quads, one glyph per code point with the default replacements; see
+// fpf_layout_text() and fpf_utf8_to_glyph_indices().
+// Returns: the number of vertices written.
+size_t fpf_layout_utf8_text(
+    const char *const           text,               // [in]  UTF-8 text to lay out.
+    const size_t                length,             // [in]  Number of bytes of text.
+    const float                 x,                  // [in]  Left edge of the text in pixels.
+    const float                 y,                  // [in]  Top edge of the text in pixels.
+    const unsigned int          color,              // [in]  Color stored in every vertex.
+    const fpf_y_axis_direction  y_axis_direction,   // [in]  Direction of the texture's y-axis.
+    fpf_vertex *const           p_vertices,         // [out] Vertex buffer to fill.
+    const size_t                max_vertices        // [in]  Capacity of the vertex buffer in vertices.
+    )
+{
+    unsigned char glyph_indices[128];
+    float pen_x = x;
+    float pen_y = y;
+    size_t byte_index = 0;
+    size_t vertex_count = 0;
+
+    FPF_PROFILE_BEGIN("fpf_layout_utf8_text");
+    FPF_assert(NULL != text || 0 == length);
+    FPF_assert(NULL != p_vertices || 0 == max_vertices);
+    FPF_STAT_ADD(layout_calls, 1);
+
+    // Convert and lay out a chunk at a time.
+    while (byte_index < length && max_vertices - vertex_count >= FPF_VERTICES_PER_GLYPH)
+    {
+        size_t bytes_used;
+        const size_t glyph_count = fpf_utf8_to_glyph_indices(
+            text + byte_index, length - byte_index, NULL, 0,
+            glyph_indices, sizeof(glyph_indices), &bytes_used);
+
+        vertex_count += fpf_layout_glyph_run(glyph_indices, glyph_count, x, &pen_x, &pen_y, color, y_axis_direction,
+                                             &p_vertices[vertex_count], max_vertices - vertex_count);
+        byte_index += bytes_used;
+    }
+
+    FPF_PROFILE_END("fpf_layout_utf8_text");
+    return vertex_count;
+}
+
+// Finds the end of the line of text starting at start.
+// Returns: the index of the line's newline, or length if it's the last line.
+size_t fpf_find_line_end(
+    const char *const   text,   // [in] Text.
+    const size_t        start,  // [in] Index of the first character of the line.
+    const size_t        length  // [in] Number of characters in the text.
+    )
+{
+    const char *const p_newline = (const char *)FPF_memchr(text + start, '\n', length - start);
+    return (NULL != p_newline) ? (size_t)(p_newline - text) : length;
+}
+
+// Works out which character cells of a line are inside a clip rectangle's left and right edges.
+// Every character (spaces included) takes one FPF_GLYPH_WIDTH cell, so this is arithmetic rather
+// than a walk along the line.
+void fpf_clip_line_columns(
+    const float                 line_x,         // [in]  Left edge of the line in pixels.
+    const size_t                line_length,    // [in]  Number of characters in the line.
+    const fpf_clip_rect *const  p_clip,         // [in]  Clip rectangle.
+    size_t *const               p_first,        // [out] First column at least partly inside.
+    size_t *const               p_end           // [out] One past the last column at least partly inside.
+    )
+{
+    const float first = ((float)p_clip->left - line_x) / FPF_GLYPH_WIDTH;
+    const float end = ((float)p_clip->right - line_x) / FPF_GLYPH_WIDTH;
+
+    *p_first = (first <= 0.0f) ? 0 : (first >= (float)line_length) ? line_length : (size_t)first;
+
+    if (end <= 0.0f)
+    {
+        *p_end = 0;
+    }
+    else if (end >= (float)line_length)
+    {
+        *p_end = line_length;
+    }
+    else
+    {
+        *p_end = (size_t)end + (((float)(size_t)end < end) ? 1 : 0);
+    }
+
+    if (*p_end < *p_first)
+    {
+        *p_end = *p_first;
+    }
+}
+
+// Lays out text as glyph quads like fpf_layout_text(), but only the glyphs inside a clip
+// rectangle. Whole lines above and below the rectangle, and the characters of each line left and
+// right of it, are skipped without being looked at (beyond finding each newline). Glyphs that are
+// partly inside are trimmed to the rectangle, texture coordinates included, so no scissor state is
+// needed. Once the vertex buffer fills, the remaining lines are still walked to finish the culled
+// count; characters inside the rectangle that didn't fit aren't counted as culled.
+// Returns: the number of vertices written.
+size_t fpf_layout_text_clipped(
+    const char *const           text,               // [in]  Text to lay out.
+    const size_t                length,             // [in]  Number of characters in the text.
+    const float                 x,                  // [in]  Left edge of the text in pixels.
+    const float                 y,                  // [in]  Top edge of the text in pixels.
+    const unsigned int          color,              // [in]  Color stored in every vertex.
+    const fpf_y_axis_direction  y_axis_direction,   // [in]  Direction of the texture's y-axis (picks DX or GL texture coordinates).
+    const fpf_clip_rect *const  p_clip,             // [in]  Clip rectangle in pixels.
+    fpf_vertex *const           p_vertices,         // [out] Vertex buffer to fill.
+    const size_t                max_vertices,       // [in]  Capacity of the vertex buffer in vertices.
+    size_t *const               p_culled_count      // [out] Optional; number of characters (other than newlines) outside the clip rectangle.
+    )
+{
+    float line_y = y;
+    size_t line_start = 0;
+    size_t vertex_count = 0;
+    size_t culled_count = 0;
+    int full = 0;
+
+    FPF_PROFILE_BEGIN("fpf_layout_text_clipped");
+    FPF_assert(NULL != text || 0 == length);
+    FPF_assert(NULL != p_clip);
+    FPF_assert(NULL != p_vertices || 0 == max_vertices);
+    FPF_STAT_ADD(layout_calls, 1);
+
+    while (line_start < length)
+    {
+        const size_t line_end = fpf_find_line_end(text, line_start, length);
+        const size_t line_length = line_end - line_start;
+        size_t first;
+        size_t end;
+        size_t i; // For loops.
+
+        if ((full || line_y >= (float)p_clip->bottom) && NULL == p_culled_count) // if (nothing left to emit or count)
+        {
+            break;
+        }
+
+        if (line_y >= (float)p_clip->bottom || line_y + FPF_GLYPH_HEIGHT <= (float)p_clip->top) // if (line is outside)
+        {
+            culled_count += line_length;
+            line_start = line_end + 1;
+            line_y += FPF_GLYPH_HEIGHT;
+            continue;
+        }
+
+        fpf_clip_line_columns(x, line_length, p_clip, &first, &end);
+        culled_count += line_length - (end - first);
+
+        for (i = first; i < end && !full; ++i)
+        {
+            const char character = text[line_start + i];
+            float x0 = x + (float)(i * FPF_GLYPH_WIDTH);
+            float y0 = line_y;
+            float x1 = x0 + FPF_GLYPH_WIDTH;
+            float y1 = y0 + FPF_GLYPH_HEIGHT;
+            float u0;
+            float v0;
+            float u1;
+            float v1;
+
+            if (' ' == character || '\t' == character)
+            {
+                continue;
+            }
+
+            if (vertex_count + FPF_VERTICES_PER_GLYPH > max_vertices) // if (out of room)
+            {
+                full = 1;
+                break;
+            }
+
+            if (FPF_RASTER_Y_AXIS == y_axis_direction)
+            {
+                fpf_get_glyph_dx_texture_coordinates(character, &u0, &v0, &u1, &v1);
+            }
+            else
+            {
+                fpf_get_glyph_gl_texture_coordinates(character, &u0, &v0, &u1, &v1);
+            }
+
+            // Trim glyphs on the edges (v runs either way, depending on the y-axis direction).
+            if (x0 < (float)p_clip->left || x1 > (float)p_clip->right ||
+                y0 < (float)p_clip->top || y1 > (float)p_clip->bottom)
+            {
+                const float texels_per_pixel_x = (u1 - u0) / FPF_GLYPH_WIDTH;
+                const float texels_per_pixel_y = (v1 - v0) / FPF_GLYPH_HEIGHT;
+
+                if (x0 < (float)p_clip->left)
+                {
+                    u0 += texels_per_pixel_x * ((float)p_clip->left - x0);
+                    x0 = (float)p_clip->left;
+                }
+
+                if (x1 > (float)p_clip->right)
+                {
+                    u1 -= texels_per_pixel_x * (x1 - (float)p_clip->right);
+                    x1 = (float)p_clip->right;
+                }
+
+                if (y0 < (float)p_clip->top)
+                {
+                    v0 += texels_per_pixel_y * ((float)p_clip->top - y0);
+                    y0 = (float)p_clip->top;
+                }
+
+                if (y1 > (float)p_clip->bottom)
+                {
+                    v1 -= texels_per_pixel_y * (y1 - (float)p_clip->bottom);
+                    y1 = (float)p_clip->bottom;
+                }
+            }
+
+            fpf_emit_quad(&p_vertices[vertex_count], x0, y0, x1, y1, u0, v0, u1, v1, color);
+            vertex_count += FPF_VERTICES_PER_GLYPH;
+        }
+
+        line_start = line_end + 1;
+        line_y += FPF_GLYPH_HEIGHT;
+    }
+
+    if (NULL != p_culled_count)
+    {
+        *p_culled_count = culled_count;
+    }
+
+    FPF_STAT_ADD(glyphs_emitted, vertex_count / FPF_VERTICES_PER_GLYPH);
+    FPF_PROFILE_END("fpf_layout_text_clipped");
+    return vertex_count;
+}
+
+// Draws text inside a clip rectangle; see fpf_draw_text_alpha8_clipped(). Leaves the FPF_STATS
+// counters alone, so threads drawing to separate parts of a surface can share it.
+size_t fpf_draw_text_alpha8_clipped_uncounted(
+    const unsigned char *const  p_glyph_bits,   // [in]     Glyph bits from fpf_create_glyph_bits().
+    unsigned char *const        p_surface,      // [in/out] Surface to draw on; first byte is the top-left pixel.
+    const unsigned int          width,          // [in]     Width of the surface in pixels.
+    const unsigned int          height,         // [in]     Height of the surface in pixels.
+    const size_t                line_pitch,     // [in]     Line pitch of the surface in bytes.
+    const int                   x,              // [in]     Left edge of the text in pixels.
+    const int                   y,              // [in]     Top edge of the text in pixels.
+    const char *const           text,           // [in]     Text to draw.
+    const size_t                length,         // [in]     Number of characters in the text.
+    const unsigned char         alpha,          // [in]     Value written for glyph pixels.
+    const fpf_clip_rect *const  p_clip,         // [in]     Clip rectangle in pixels, or NULL for the whole surface.
+    size_t *const               p_culled_count  // [out]    Optional; number of characters (other than newlines) outside the clip rectangle.
+    )
+{
+    fpf_clip_rect clip;
+    int line_y = y;
+    size_t line_start = 0;
+    size_t glyph_count = 0;
+    size_t culled_count = 0;
+
+    FPF_assert(NULL != p_glyph_bits);
+    FPF_assert(NULL != p_surface);
+    FPF_assert(NULL != text || 0 == length);
+
+    // Clip the clip rectangle to the surface.
+    clip.left = 0;
+    clip.top = 0;
+    clip.right = (int)width;
+    clip.bottom = (int)height;
+
+    if (NULL != p_clip)
+    {
+        clip.left = (p_clip->left > clip.left) ? p_clip->left : clip.left;
+        clip.top = (p_clip->top > clip.top) ? p_clip->top : clip.top;
+        clip.right = (p_clip->right < clip.right) ? p_clip->right : clip.right;
+        clip.bottom = (p_clip->bottom < clip.bottom) ? p_clip->bottom : clip.bottom;
+    }
+
+    while (line_start < length)
+    {
+        const size_t line_end = fpf_find_line_end(text, line_start, length);
+        const size_t line_length = line_end - line_start;
+        const int first_row = (clip.top > line_y) ? clip.top - line_y : 0;
+        const int end_row = (clip.bottom - line_y < (int)FPF_GLYPH_HEIGHT) ? clip.bottom - line_y : (int)FPF_GLYPH_HEIGHT;
+        size_t first;
+        size_t end;
+        size_t i; // For loops.
+
+        if (line_y >= clip.bottom && NULL == p_culled_count) // if (the rest is below and uncounted)
+        {
+            break;
+        }
+
+        if (first_row >= end_row || clip.left >= clip.right) // if (line is outside)
+        {
+            culled_count += line_length;
+            line_start = line_end + 1;
+            line_y += FPF_GLYPH_HEIGHT;
+            continue;
+        }
+
+        fpf_clip_line_columns((float)x, line_length, &clip, &first, &end);
+        culled_count += line_length - (end - first);
+
+        for (i = first; i < end; ++i)
+        {
+            const char character = text[line_start + i];
+            const int pen_x = x + (int)(i * FPF_GLYPH_WIDTH);
+            const unsigned char *p_rows;
+            unsigned int column_mask = 0xff;
+            int row; // For loops.
+            int column; // For loops.
+
+            if (' ' == character || '\t' == character)
+            {
+                continue;
+            }
+
+            // Mask off the columns outside the clip rectangle (left-most pixel in the top bit).
+            if (clip.left > pen_x)
+            {
+                column_mask &= 0xffu >> (clip.left - pen_x);
+            }
+
+            if (clip.right - pen_x < 8)
+            {
+                column_mask &= (0xffu << (8 - (clip.right - pen_x))) & 0xff;
+            }
+
+            p_rows = &p_glyph_bits[fpf_get_glyph_index(character) * FPF_GLYPH_HEIGHT];
+
+            for (row = first_row; row < end_row; ++row)
+            {
+                unsigned char *const p_dst = &p_surface[(line_y + row) * line_pitch];
+                unsigned int bits = p_rows[row] & column_mask;
+
+                for (column = pen_x; 0 != bits; ++column, bits = (bits << 1) & 0xff)
+                {
+                    if (bits & 0x80)
+                    {
+                        p_dst[column] = alpha;
+                    }
+                }
+            }
+
+            ++glyph_count;
+        }
+
+        line_start = line_end + 1;
+        line_y += FPF_GLYPH_HEIGHT;
+    }
+
+    if (NULL != p_culled_count)
+    {
+        *p_culled_count = culled_count;
+    }
+
+    return glyph_count;
+}
+
+// Draws text into an 8-bit surface like fpf_draw_text_alpha8(), but only inside a clip rectangle
+// (which is also clipped to the surface). Lines and characters outside the rectangle are skipped
+// the same way as fpf_layout_text_clipped().
+// Returns: the number of glyphs drawn (at least partly inside the clip rectangle).
+size_t fpf_draw_text_alpha8_clipped(
+    const unsigned char *const  p_glyph_bits,   // [in]     Glyph bits from fpf_create_glyph_bits().
+    unsigned char *const        p_surface,      // [in/out] Surface to draw on; first byte is the top-left pixel.
+    const unsigned int          width,          // [in]     Width of the surface in pixels.
+    const unsigned int          height,         // [in]     Height of the surface in pixels.
+    const size_t                line_pitch,     // [in]     Line pitch of the surface in bytes.
+    const int                   x,              // [in]     Left edge of the text in pixels.
+    const int                   y,              // [in]     Top edge of the text in pixels.
+    const char *const           text,           // [in]     Text to draw.
+    const size_t                length,         // [in]     Number of characters in the text.
+    const unsigned char         alpha,          // [in]     Value written for glyph pixels.
+    const fpf_clip_rect *const  p_clip,         // [in]     Clip rectangle in pixels, or NULL for the whole surface.
+    size_t *const               p_culled_count  // [out]    Optional; number of characters (other than newlines) outside the clip rectangle.
+    )
+{
+    size_t glyph_count;
+    FPF_PROFILE_BEGIN("fpf_draw_text_alpha8_clipped");
+    glyph_count = fpf_draw_text_alpha8_clipped_uncounted(p_glyph_bits, p_surface, width, height, line_pitch, x, y,
+                                                         text, length, alpha, p_clip, p_culled_count);
+    FPF_STAT_ADD(glyphs_emitted, glyph_count);
+    FPF_PROFILE_END("fpf_draw_text_alpha8_clipped");
+    return glyph_count;
+}
+
+// Glyph bit of each pixel of a scaled glyph row; entry [scale - 1][x] is the bit (in a row from
+// fpf_create_glyph_bits()) that covers pixel x of the row, or 0 past the end of the cell.
+const unsigned char fpf_scaled_row_bit_masks[FPF_MAX_SCALE][FPF_GLYPH_WIDTH * FPF_MAX_SCALE] =
+{
+    {   // x1
+        0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    {   // x2
+        0x80, 0x80, 0x40, 0x40, 0x20, 0x20, 0x10, 0x10, 0x08, 0x08, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    {   // x3
+        0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x20, 0x20, 0x20, 0x10, 0x10, 0x10, 0x08, 0x08, 0x08, 0x04,
+        0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    {   // x4
+        0x80, 0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x40, 0x20, 0x20, 0x20, 0x20, 0x10, 0x10, 0x10, 0x10,
+        0x08, 0x08, 0x08, 0x08, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    {   // x5
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x40, 0x40, 0x20, 0x20, 0x20, 0x20, 0x20, 0x10,
+        0x10, 0x10, 0x10, 0x10, 0x08, 0x08, 0x08, 0x08, 0x08, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    {   // x6
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x20, 0x20, 0x20, 0x20,
+        0x20, 0x20, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x04, 0x04,
+        0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    {   // x7
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x20, 0x20,
+        0x20, 0x20, 0x20, 0x20, 0x20, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x08, 0x08, 0x08, 0x08,
+        0x08, 0x08, 0x08, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    },
+    {   // x8
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40,
+        0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04
+    }
+};
+
+// Writes one scaled glyph row, scale rows high, where the whole cell (rounded up to 16 bytes) is
+// inside the surface.
+void fpf_write_scaled_glyph_row(
+    unsigned char *const    p_dst,              // [in/out] First byte of the cell's first row.
+    const size_t            line_pitch,         // [in]     Line pitch of the surface in bytes.
+    const unsigned int      row_count,          // [in]     Number of surface rows to write (up to scale).
+    const unsigned int      row_bits,           // [in]     Glyph row bits, left-most pixel in the top bit.
+    const unsigned int      scale,              // [in]     Pixels per glyph pixel.
+    const unsigned int      bytes_per_pixel,    // [in]     1 or 4.
+    const unsigned int      pixel               // [in]     Value written for glyph pixels.
+    )
+{
+    const unsigned char *const p_bit_masks = fpf_scaled_row_bit_masks[scale - 1];
+    const unsigned int pixel_count = FPF_GLYPH_WIDTH * scale;
+    unsigned int i; // For loops.
+    unsigned int row; // For loops.
+
+#ifdef FPF_SSE2
+    // Expand the row into pixel masks once (16 bytes at a time), then blend them into each row.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i bits = _mm_set1_epi8((char)row_bits);
+    const __m128i value = (1 == bytes_per_pixel) ? _mm_set1_epi8((char)pixel) : _mm_set1_epi32((int)pixel);
+    const unsigned int chunk_count = (pixel_count * bytes_per_pixel + 15) / 16;
+    __m128i masks[FPF_GLYPH_WIDTH * FPF_MAX_SCALE * 4 / 16];
+
+    for (i = 0; i < chunk_count; ++i)
+    {
+        __m128i select;
+
+        if (1 == bytes_per_pixel)
+        {
+            select = _mm_loadu_si128((const __m128i *)&p_bit_masks[i * 16]);
+        }
+        else
+        {
+            // Widen four byte masks to four 32-bit lanes.
+            int four_masks;
+            FPF_memcpy(&four_masks, &p_bit_masks[i * 4], sizeof(four_masks));
+            select = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(four_masks), zero), zero);
+        }
+
+        masks[i] = (1 == bytes_per_pixel) ?
+            _mm_andnot_si128(_mm_cmpeq_epi8(_mm_and_si128(bits, select), zero), ones) :
+            _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(bits, select), zero), ones);
+    }
+
+    for (row = 0; row < row_count; ++row)
+    {
+        unsigned char *const p_row = p_dst + row * line_pitch;
+
+        for (i = 0; i < chunk_count; ++i)
+        {
+            if (0 != _mm_movemask_epi8(masks[i]))
+            {
+                const __m128i dst = _mm_loadu_si128((const __m128i *)&p_row[i * 16]);
+                _mm_storeu_si128((__m128i *)&p_row[i * 16],
+                    _mm_or_si128(_mm_and_si128(masks[i], value), _mm_andnot_si128(masks[i], dst)));
+            }
+        }
+    }
+#else
+    for (row = 0; row < row_count; ++row)
+    {
+        unsigned char *const p_row = p_dst + row * line_pitch;
+
+        for (i = 0; i < pixel_count; ++i)
+        {
+            if (row_bits & p_bit_masks[i])
+            {
+                if (1 == bytes_per_pixel)
+                {
+                    p_row[i] = (unsigned char)pixel;
+                }
+                else
+                {
+                    FPF_memcpy(&p_row[i * 4], &pixel, 4);
+                }
+            }
+        }
+    }
+#endif
+}
+
+// Draws text at an integer scale; see fpf_draw_text_alpha8_scaled().
+size_t fpf_draw_text_scaled(
+    const unsigned char *const  p_glyph_bits,       // [in]     Glyph bits from fpf_create_glyph_bits().
+    unsigned char *const        p_surface,          // [in/out] Surface to draw on; first byte is the top-left pixel.
+    const unsigned int          width,              // [in]     Width of the surface in pixels.
+    const unsigned int          height,             // [in]     Height of the surface in pixels.
+    const size_t                line_pitch,         // [in]     Line pitch of the surface in bytes.
+    const int                   x,                  // [in]     Left edge of the text in pixels.
+    const int                   y,                  // [in]     Top edge of the text in pixels.
+    const char *const           text,               // [in]     Text to draw.
+    const size_t                length,             // [in]     Number of characters in the text.
+    const unsigned int          scale,              // [in]     Pixels per glyph pixel (1 to FPF_MAX_SCALE).
+    const unsigned int          bytes_per_pixel,    // [in]     1 or 4.
+    const unsigned int          pixel               // [in]     Value written for glyph pixels.
+    )
+{
+    const int cell_width = (int)(FPF_GLYPH_WIDTH * scale);
+    const int cell_height = (int)(FPF_GLYPH_HEIGHT * scale);
+
+    // Cells drawn with whole 16-byte writes must have room for them.
+    const int padded_width = (int)((((unsigned int)cell_width * bytes_per_pixel + 15) & ~15u) / bytes_per_pixel);
+    int pen_x = x;
+    int pen_y = y;
+    size_t glyph_count = 0;
+    size_t i; // For loops.
+
+    FPF_assert(NULL != p_glyph_bits);
+    FPF_assert(NULL != p_surface);
+    FPF_assert(NULL != text || 0 == length);
+    FPF_assert(scale >= 1 && scale <= FPF_MAX_SCALE);
+
+    for (i = 0; i < length; ++i)
+    {
+        const char character = text[i];
+        const unsigned char *p_rows;
+        int row; // For loops.
+
+        if ('\n' == character)
+        {
+            pen_x = x;
+            pen_y += cell_height;
+            continue;
+        }
+
+        if (' ' == character || '\t' == character ||
+            pen_x >= (int)width || pen_y >= (int)height ||
+            pen_x + cell_width <= 0 || pen_y + cell_height <= 0) // if (nothing to draw)
+        {
+            pen_x += cell_width;
+            continue;
+        }
+
+        p_rows = &p_glyph_bits[fpf_get_glyph_index(character) * FPF_GLYPH_HEIGHT];
+
+        for (row = 0; row < (int)FPF_GLYPH_HEIGHT; ++row)
+        {
+            const unsigned int row_bits = p_rows[row];
+            const int top = pen_y + row * (int)scale;
+            const int first_row = (top < 0) ? 0 : top;
+            const int end_row = (top + (int)scale > (int)height) ? (int)height : top + (int)scale;
+            unsigned char *const p_dst = p_surface + (size_t)first_row * line_pitch;
+            int column; // For loops.
+            int k; // For loops.
+
+            if (0 == row_bits || first_row >= end_row)
+            {
+                continue;
+            }
+
+            if (pen_x >= 0 && pen_x + padded_width <= (int)width) // if (the cell is all on the surface)
+            {
+                fpf_write_scaled_glyph_row(p_dst + (size_t)pen_x * bytes_per_pixel, line_pitch,
+                                           (unsigned int)(end_row - first_row), row_bits, scale, bytes_per_pixel,
+                                           pixel);
+                continue;
+            }
+
+            // Clipped on the left or right; one pixel at a time.
+            for (k = 0; k < end_row - first_row; ++k)
+            {
+                unsigned char *const p_row = p_dst + (size_t)k * line_pitch;
+
+                for (column = 0; column < cell_width; ++column)
+                {
+                    const int surface_x = pen_x + column;
+
+                    if (surface_x >= 0 && surface_x < (int)width &&
+                        (row_bits & fpf_scaled_row_bit_masks[scale - 1][column]))
+                    {
+                        if (1 == bytes_per_pixel)
+                        {
+                            p_row[surface_x] = (unsigned char)pixel;
+                        }
+                        else
+                        {
+                            FPF_memcpy(&p_row[surface_x * 4], &pixel, 4);
+                        }
+                    }
+                }
+            }
+        }
+
+        ++glyph_count;
+        pen_x += cell_width;
+    }
+
+    FPF_STAT_ADD(glyphs_emitted, glyph_count);
+    return glyph_count;
+}
+
+// Draws text into an 8-bit surface like fpf_draw_text_alpha8(), with each glyph pixel drawn as a
+// scale x scale block (2x to 8x for high resolution targets). Rows of glyph pixels are expanded
+// once and written as whole scaled rows (16 bytes at a time with SSE2).
+// Returns: the number of glyphs drawn (at least partly on the surface).
+size_t fpf_draw_text_alpha8_scaled(
+    const unsigned char *const  p_glyph_bits,   // [in]     Glyph bits from fpf_create_glyph_bits().
+    unsigned char *const        p_surface,      // [in/out] Surface to draw on; first byte is the top-left pixel.
+    const unsigned int          width,          // [in]     Width of the surface in pixels.
+    const unsigned int          height,         // [in]     Height of the surface in pixels.
+    const size_t                line_pitch,     // [in]     Line pitch of the surface in bytes.
+    const int                   x,              // [in]     Left edge of the text in pixels.
+    const int                   y,              // [in]     Top edge of the text in pixels.
+    const char *const           text,           // [in]     Text to draw.
+    const size_t                length,         // [in]     Number of characters in the text.
+    const unsigned char         alpha,          // [in]     Value written for glyph pixels.
+    const unsigned int          scale           // [in]     Pixels per glyph pixel (1 to FPF_MAX_SCALE).
+    )
+{
+    size_t glyph_count;
+    FPF_PROFILE_BEGIN("fpf_draw_text_alpha8_scaled");
+    glyph_count = fpf_draw_text_scaled(p_glyph_bits, p_surface, width, height, line_pitch, x, y, text, length, scale,
+                                       1, alpha);
+    FPF_PROFILE_END("fpf_draw_text_alpha8_scaled");
+    return glyph_count;
+}
+
+// Draws text into a 32-bit surface (RGBA, BGRA or anything else four bytes per pixel) at an integer
+// scale; see fpf_draw_text_alpha8_scaled(). Glyph pixels are set to color, as is.
+// Returns: the number of glyphs drawn (at least partly on the surface).
+size_t fpf_draw_text_rgba32_scaled(
+    const unsigned char *const  p_glyph_bits,   // [in]     Glyph bits from fpf_create_glyph_bits().
+    void *const                 p_surface,      // [in/out] Surface to draw on; first pixel is the top-left.
+    const unsigned int          width,          // [in]     Width of the surface in pixels.
+    const unsigned int          height,         // [in]     Height of the surface in pixels.
+    const size_t                line_pitch,     // [in]     Line pitch of the surface in bytes.
+    const int                   x,              // [in]     Left edge of the text in pixels.
+    const int                   y,              // [in]     Top edge of the text in pixels.
+    const char *const           text,           // [in]     Text to draw.
+    const size_t                length,         // [in]     Number of characters in the text.
+    const unsigned int          color,          // [in]     Pixel value written for glyph pixels.
+    const unsigned int          scale           // [in]     Pixels per glyph pixel (1 to FPF_MAX_SCALE).
+    )
+{
+    size_t glyph_count;
+    FPF_PROFILE_BEGIN("fpf_draw_text_rgba32_scaled");
+    glyph_count = fpf_draw_text_scaled(p_glyph_bits, (unsigned char *)p_surface, width, height, line_pitch, x, y, text,
+                                       length, scale, 4, color);
+    FPF_PROFILE_END("fpf_draw_text_rgba32_scaled");
+    return glyph_count;
+}
+
+// Creates a single channel (alpha) signed distance field texture atlas, so one texture can be
+// drawn (with bilinear filtering) at any scale or rotation. Each font pixel is
+// FPF_SDF_TEXELS_PER_PIXEL texels, and each glyph cell is padded by spread texels on every side.
+// Texels hold the distance to the glyph's edge (127.5 on the edge, higher inside), reaching 255
+// and 0 at spread texels in and out. Distances are square (the largest of the horizontal and
+// vertical distances) rather than round, which keeps the corners of the pixel art square when
+// the field is scaled up. The atlas is FPF_SDF_TEXTURE_WIDTH(spread) x
+// FPF_SDF_TEXTURE_HEIGHT(spread) texels; see fpf_get_glyph_sdf_position().
+// Returns: 0 on success, otherwise the size (in bytes) required to draw the font.
+size_t fpf_create_sdf_texture(
+    unsigned char *const        p_alpha_texture,                // [in/out] Texture memory to draw the font into.
+    const size_t                alpha_texture_size_in_bytes,    // [in]     Size of the texture memory in bytes.
+    const size_t                line_pitch,                     // [in]     Line pitch of the texture memory in bytes.
+    const fpf_y_axis_direction  y_axis_direction,               // [in]     Direction of the textures y-axis.
+    const unsigned int          spread                          // [in]     Distance (in texels, 1 to FPF_SDF_MAX_SPREAD) the field reaches.
+    )
+{
+    const int texels_per_pixel = (int)FPF_SDF_TEXELS_PER_PIXEL;
+    const unsigned int cell_size = FPF_SDF_CELL_SIZE(spread);
+    const unsigned int texture_width = FPF_SDF_TEXTURE_WIDTH(spread);
+    const unsigned int texture_height = FPF_SDF_TEXTURE_HEIGHT(spread);
+    const size_t required_bytes = (size_t)texture_width * texture_height;
+
+    // Font pixels close enough to a texel to matter.
+    const int search_radius = ((int)spread + texels_per_pixel - 1) / texels_per_pixel + 1;
+
+    unsigned char atlas_bits[FPF_TEXTURE_HEIGHT][FPF_ROW_BITS_SIZE];
+    unsigned int glyph_index;
+    unsigned int tx; // For loops.
+    unsigned int ty; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_create_sdf_texture");
+    FPF_assert(NULL != p_alpha_texture);
+    FPF_assert(spread >= 1 && spread <= FPF_SDF_MAX_SPREAD);
+
+    if (line_pitch < texture_width) // if (line pitch is too short)
+    {
+        FPF_PROFILE_END("fpf_create_sdf_texture");
+        return required_bytes;
+    }
+
+    if (alpha_texture_size_in_bytes < line_pitch * texture_height)
+    {
+        FPF_PROFILE_END("fpf_create_sdf_texture");
+        return line_pitch * texture_height;
+    }
+
+    fpf_decode_atlas_bits(atlas_bits);
+
+    for (ty = 0; ty < texture_height; ++ty)
+    {
+        unsigned char *const p_dst = (FPF_RASTER_Y_AXIS == y_axis_direction) ?
+            &p_alpha_texture[ty * line_pitch] : &p_alpha_texture[(texture_height - 1 - ty) * line_pitch];
+
+        FPF_memset(p_dst, 0x00, texture_width);
+
+        for (tx = 0; tx < texture_width; ++tx)
+        {
+            // Texel center relative to the glyph's top-left corner, in half texels (to stay integer).
+            const int x2 = (int)(2 * (tx % cell_size) + 1) - 2 * (int)spread;
+            const int y2 = (int)(2 * (ty % cell_size) + 1) - 2 * (int)spread;
+            const int pixel_x = (x2 >= 0) ? x2 / (2 * texels_per_pixel) : -((2 * texels_per_pixel - 1 - x2) / (2 * texels_per_pixel));
+            const int pixel_y = (y2 >= 0) ? y2 / (2 * texels_per_pixel) : -((2 * texels_per_pixel - 1 - y2) / (2 * texels_per_pixel));
+            int distance = 2 * (int)spread; // In half texels; saturated until something closer turns up.
+            unsigned char inside;
+            int value;
+            int i; // For loops.
+            int j; // For loops.
+
+            glyph_index = (ty / cell_size) * FPF_SDF_CELLS_PER_ROW + tx / cell_size;
+
+            if (glyph_index >= FPF_GLYPH_COUNT)
+            {
+                continue;
+            }
+
+            inside = fpf_get_glyph_texel(atlas_bits, glyph_index, pixel_x, pixel_y);
+
+            // The distance to the nearest pixel of the other kind is the distance to the edge.
+            for (j = pixel_y - search_radius; j <= pixel_y + search_radius; ++j)
+            {
+                for (i = pixel_x - search_radius; i <= pixel_x + search_radius; ++i)
+                {
+                    int dx;
+                    int dy;
+
+                    if (fpf_get_glyph_texel(atlas_bits, glyph_index, i, j) == inside)
+                    {
+                        continue;
+                    }
+
+                    dx = x2 - (2 * i + 1) * texels_per_pixel;
+                    dy = y2 - (2 * j + 1) * texels_per_pixel;
+                    dx = ((dx < 0) ? -dx : dx) - texels_per_pixel;
+                    dy = ((dy < 0) ? -dy : dy) - texels_per_pixel;
+
+                    if (dx > dy && dx < distance)
+                    {
+                        distance = dx;
+                    }
+                    else if (dy >= dx && dy < distance)
+                    {
+                        distance = dy;
+                    }
+                }
+            }
+
+            // Map [-spread, spread] texels onto [255, 0], rounded.
+            value = inside ?
+                (int)((127.5f + 127.5f * (float)distance / (float)(2 * spread)) + 0.5f) :
+                (int)((127.5f - 127.5f * (float)distance / (float)(2 * spread)) + 0.5f);
+            p_dst[tx] = (unsigned char)((value < 0) ? 0 : (value > 255) ? 255 : value);
+        }
+    }
+
+    FPF_STAT_ADD(texture_bytes_written, required_bytes);
+    FPF_PROFILE_END("fpf_create_sdf_texture");
+    return 0;
+}
+
+// Gets the position of a glyph's 6x6 pixel cell (inside its padding) in the distance field atlas.
+void fpf_get_sdf_cell_position(
+    const unsigned int  glyph_index,    // [in]  Index of the glyph.
+    const unsigned int  spread,         // [in]  Spread the atlas was created with.
+    unsigned int *const x,              // [out] Column of the glyph.
+    unsigned int *const y               // [out] Row of the glyph.
+    )
+{
+    FPF_assert(NULL != x);
+    FPF_assert(NULL != y);
+    *x = (glyph_index % FPF_SDF_CELLS_PER_ROW) * FPF_SDF_CELL_SIZE(spread) + spread;
+    *y = (glyph_index / FPF_SDF_CELLS_PER_ROW) * FPF_SDF_CELL_SIZE(spread) + spread;
+}
+
+// Gets the [column, row] position of a character's glyph in the distance field atlas. The glyph's
+// 6x6 pixel cell is FPF_GLYPH_WIDTH * FPF_SDF_TEXELS_PER_PIXEL texels square.
+void fpf_get_glyph_sdf_position(
+    const char          character,  // [in]  Character to locate.
+    const unsigned int  spread,     // [in]  Spread the atlas was created with.
+    unsigned int *const x,          // [out] Column of the glyph.
+    unsigned int *const y           // [out] Row of the glyph.
+    )
+{
+    FPF_PROFILE_BEGIN("fpf_get_glyph_sdf_position");
+    fpf_get_sdf_cell_position(fpf_get_glyph_index(character), spread, x, y);
+    FPF_PROFILE_END("fpf_get_glyph_sdf_position");
+}
+
+// Gets the texture coordinates of a character's glyph in the distance field atlas. They cover the
+// same 6x6 pixel cell as fpf_get_glyph_dx_texture_coordinates(), so quads are the same size.
+void fpf_get_glyph_sdf_dx_texture_coordinates(
+    const char          character,  // [in]  Character to locate.
+    const unsigned int  spread,     // [in]  Spread the atlas was created with.
+    float *const        left,       // [out] Left bound of the character's glyph.
+    float *const        top,        // [out] Top bound of the character's glyph.
+    float *const        right,      // [out] Right bound of the character's glyph.
+    float *const        bottom      // [out] Bottom bound of the character's glyph.
+    )
+{
+    const unsigned int glyph_size = FPF_GLYPH_WIDTH * FPF_SDF_TEXELS_PER_PIXEL;
+    unsigned int x;
+    unsigned int y;
+    FPF_PROFILE_BEGIN("fpf_get_glyph_sdf_dx_texture_coordinates");
+    FPF_assert(NULL != left);
+    FPF_assert(NULL != top);
+    FPF_assert(NULL != right);
+    FPF_assert(NULL != bottom);
+    fpf_get_glyph_sdf_position(character, spread, &x, &y);
+    *left = (float)x / FPF_SDF_TEXTURE_WIDTH(spread);
+    *top = (float)y / FPF_SDF_TEXTURE_HEIGHT(spread);
+    *right = (float)(x + glyph_size) / FPF_SDF_TEXTURE_WIDTH(spread);
+    *bottom = (float)(y + glyph_size) / FPF_SDF_TEXTURE_HEIGHT(spread);
+    FPF_PROFILE_END("fpf_get_glyph_sdf_dx_texture_coordinates");
+}
+
+// Gets the texture coordinates of a character's glyph in the distance field atlas.
+void fpf_get_glyph_sdf_gl_texture_coordinates(
+    const char          character,  // [in]  Character to locate.
+    const unsigned int  spread,     // [in]  Spread the atlas was created with.
+    float *const        left,       // [out] Left bound of the character's glyph.
+    float *const        top,        // [out] Top bound of the character's glyph.
+    float *const        right,      // [out] Right bound of the character's glyph.
+    float *const        bottom      // [out] Bottom bound of the character's glyph.
+    )
+{
+    FPF_PROFILE_BEGIN("fpf_get_glyph_sdf_gl_texture_coordinates");
+    FPF_assert(NULL != left);
+    FPF_assert(NULL != top);
+    FPF_assert(NULL != right);
+    FPF_assert(NULL != bottom);
+    fpf_get_glyph_sdf_dx_texture_coordinates(character, spread, left, top, right, bottom);
+    *top = 1.0f - *top;
+    *bottom = 1.0f - *bottom;
+    FPF_PROFILE_END("fpf_get_glyph_sdf_gl_texture_coordinates");
+}
+
+// Gets the [column, row] position of a cursor glyph in the distance field atlas.
+void fpf_get_cursor_glyph_sdf_position(
+    const fpf_cursor_style  cursor_style,   // [in]  Cursor glyph style.
+    const unsigned int      spread,         // [in]  Spread the atlas was created with.
+    unsigned int *const     x,              // [out] Column of the glyph.
+    unsigned int *const     y               // [out] Row of the glyph.
+    )
+{
+    FPF_PROFILE_BEGIN("fpf_get_cursor_glyph_sdf_position");
+    fpf_get_sdf_cell_position(fpf_get_cursor_glyph_index(cursor_style), spread, x, y);
+    FPF_PROFILE_END("fpf_get_cursor_glyph_sdf_position");
+}
+
+// Gets the texture coordinates of a cursor glyph in the distance field atlas.
+void fpf_get_cursor_glyph_sdf_dx_texture_coordinates(
+    const fpf_cursor_style  cursor_style,   // [in]  Cursor glyph style.
+    const unsigned int      spread,         // [in]  Spread the atlas was created with.
+    float *const            left,           // [out] Left bound of the character's glyph.
+    float *const            top,            // [out] Top bound of the character's glyph.
+    float *const            right,          // [out] Right bound of the character's glyph.
+    float *const            bottom          // [out] Bottom bound of the character's glyph.
+    )
+{
+    const unsigned int glyph_size = FPF_GLYPH_WIDTH * FPF_SDF_TEXELS_PER_PIXEL;
+    unsigned int x;
+    unsigned int y;
+    FPF_PROFILE_BEGIN("fpf_get_cursor_glyph_sdf_dx_texture_coordinates");
+    FPF_assert(NULL != left);
+    FPF_assert(NULL != top);
+    FPF_assert(NULL != right);
+    FPF_assert(NULL != bottom);
+    fpf_get_cursor_glyph_sdf_position(cursor_style, spread, &x, &y);
+    *left = (float)x / FPF_SDF_TEXTURE_WIDTH(spread);
+    *top = (float)y / FPF_SDF_TEXTURE_HEIGHT(spread);
+    *right = (float)(x + glyph_size) / FPF_SDF_TEXTURE_WIDTH(spread);
+    *bottom = (float)(y + glyph_size) / FPF_SDF_TEXTURE_HEIGHT(spread);
+    FPF_PROFILE_END("fpf_get_cursor_glyph_sdf_dx_texture_coordinates");
+}
+
+// Gets the texture coordinates of a cursor glyph in the distance field atlas.
+void fpf_get_cursor_glyph_sdf_gl_texture_coordinates(
+    const fpf_cursor_style  cursor_style,   // [in]  Cursor glyph style.
+    const unsigned int      spread,         // [in]  Spread the atlas was created with.
+    float *const            left,           // [out] Left bound of the character's glyph.
+    float *const            top,            // [out] Top bound of the character's glyph.
+    float *const            right,          // [out] Right bound of the character's glyph.
+    float *const            bottom          // [out] Bottom bound of the character's glyph.
+    )
+{
+    FPF_PROFILE_BEGIN("fpf_get_cursor_glyph_sdf_gl_texture_coordinates");
+    FPF_assert(NULL != left);
+    FPF_assert(NULL != top);
+    FPF_assert(NULL != right);
+    FPF_assert(NULL != bottom);
+    fpf_get_cursor_glyph_sdf_dx_texture_coordinates(cursor_style, spread, left, top, right, bottom);
+    *top = 1.0f - *top;
+    *bottom = 1.0f - *bottom;
+    FPF_PROFILE_END("fpf_get_cursor_glyph_sdf_gl_texture_coordinates");
+}
+
+// Divides a product of two bytes by 255, rounded to nearest, without a divide.
+#define FPF_DIV255(v) (((v) + 128 + (((v) + 128) >> 8)) >> 8)
+
+// Blends one row of a subpixel mask, scaled by alpha, over a whole FPF_SUBPIXEL_MASK_WIDTH pixels
+// of the surface (the padding column is zero, so leaves its pixel as it was).
+void fpf_blend_subpixel_mask_row(
+    unsigned char *const        p_dst,  // [in/out] First pixel of the row on the surface.
+    const unsigned char *const  p_src,  // [in]     Row of the mask.
+    const unsigned int          alpha   // [in]     Alpha of fully covered glyph pixels.
+    )
+{
+#ifdef FPF_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi16(128);
+    const __m128i mask = _mm_loadl_epi64((const __m128i *)p_src);
+    __m128i src;
+    __m128i dst;
+
+    if (0xffff == _mm_movemask_epi8(_mm_cmpeq_epi8(mask, zero))) // if (the row is empty)
+    {
+        return;
+    }
+
+    // src = mask * alpha / 255; dst = src + dst * (255 - src) / 255; eight 16-bit lanes.
+    src = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(mask, zero), _mm_set1_epi16((short)alpha)), rounding);
+    src = _mm_srli_epi16(_mm_add_epi16(src, _mm_srli_epi16(src, 8)), 8);
+    dst = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)p_dst), zero);
+    dst = _mm_add_epi16(_mm_mullo_epi16(dst, _mm_sub_epi16(_mm_set1_epi16(255), src)), rounding);
+    dst = _mm_add_epi16(src, _mm_srli_epi16(_mm_add_epi16(dst, _mm_srli_epi16(dst, 8)), 8));
+    _mm_storel_epi64((__m128i *)p_dst, _mm_packus_epi16(dst, zero));
+#else
+    unsigned int column; // For loops.
+
+    for (column = 0; column < FPF_SUBPIXEL_MASK_WIDTH; ++column)
+    {
+        const unsigned int src = FPF_DIV255(p_src[column] * alpha);
+
+        if (0 != src)
+        {
+            p_dst[column] = (unsigned char)(src + FPF_DIV255(p_dst[column] * (255 - src)));
+        }
+    }
+#endif
+}
+
+// Creates anti-aliased alpha masks of every glyph at phase_count evenly spaced horizontal offsets
+// within a pixel (0, 1/2 for two phases; 0, 1/4, 1/2, 3/4 for four), for drawing text at
+// fractional positions (see fpf_draw_text_alpha8_subpixel()). Each mask pixel holds the area of it
+// covered by the shifted glyph (box filtered), so phase 0 is the bitmap font itself. The masks take
+// FPF_SUBPIXEL_MASKS_SIZE(phase_count) bytes: 9,504 for two phases and 19,008 for four.
+// Returns: 0 on success, otherwise the size (in bytes) required for the masks.
+size_t fpf_create_subpixel_masks(
+    unsigned char *const    p_masks,                // [out] Subpixel masks.
+    const size_t            masks_size_in_bytes,    // [in]  Size of the masks in bytes.
+    const unsigned int      phase_count             // [in]  Offsets per pixel (1 to FPF_MAX_SUBPIXEL_PHASES).
+    )
+{
+    const size_t required_bytes = FPF_SUBPIXEL_MASKS_SIZE(phase_count);
+
+    unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+    unsigned char *p_mask = p_masks;
+    unsigned int phase; // For loops.
+    unsigned int glyph_row; // For loops.
+    unsigned int column; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_create_subpixel_masks");
+    FPF_assert(NULL != p_masks);
+    FPF_assert(phase_count >= 1 && phase_count <= FPF_MAX_SUBPIXEL_PHASES);
+
+    if (masks_size_in_bytes < required_bytes)
+    {
+        FPF_PROFILE_END("fpf_create_subpixel_masks");
+        return required_bytes;
+    }
+
+    fpf_create_glyph_bits(glyph_bits);
+
+    for (phase = 0; phase < phase_count; ++phase)
+    {
+        for (glyph_row = 0; glyph_row < FPF_GLYPH_BITS_SIZE; ++glyph_row)
+        {
+            const unsigned int bits = glyph_bits[glyph_row];
+
+            // A pixel is covered by (1 - offset) of the glyph pixel in its column and offset of the
+            // one to its left.
+            for (column = 0; column < FPF_SUBPIXEL_MASK_WIDTH; ++column)
+            {
+                // The padding column stays zero; glyph bits stop at the sixth column.
+                const unsigned int here = (0 != (bits & (0x80u >> column))) ? phase_count - phase : 0;
+                const unsigned int left = (column > 0 && 0 != (bits & (0x80u >> (column - 1)))) ? phase : 0;
+                *p_mask++ = (unsigned char)(((here + left) * 255 + phase_count / 2) / phase_count);
+            }
+        }
+    }
+
+    FPF_PROFILE_END("fpf_create_subpixel_masks");
+    return 0;
+}
+
+// Draws text into an 8-bit surface at a fractional horizontal position, for smooth scrolling.
+// The offset within a pixel is rounded to the nearest phase once for the whole string, so each
+// glyph is one lookup and a blend of a precomputed mask, the same work as text at a whole pixel.
+// Mask pixels scaled by alpha are blended over the surface (a + d * (1 - a)); on a clear surface a
+// phase 0 draw matches fpf_draw_text_alpha8(). Text is clipped to the surface, and a newline starts
+// the next line of text.
+// Returns: the number of glyphs drawn (at least partly on the surface).
+size_t fpf_draw_text_alpha8_subpixel(
+    const unsigned char *const  p_masks,        // [in]     Masks from fpf_create_subpixel_masks().
+    const unsigned int          phase_count,    // [in]     Phase count the masks were created with.
+    unsigned char *const        p_surface,      // [in/out] Surface to draw on; first byte is the top-left pixel.
+    const unsigned int          width,          // [in]     Width of the surface in pixels.
+    const unsigned int          height,         // [in]     Height of the surface in pixels.
+    const size_t                line_pitch,     // [in]     Line pitch of the surface in bytes.
+    const float                 x,              // [in]     Left edge of the text in (fractional) pixels.
+    const int                   y,              // [in]     Top edge of the text in pixels.
+    const char *const           text,           // [in]     Text to draw.
+    const size_t                length,         // [in]     Number of characters in the text.
+    const unsigned char         alpha           // [in]     Alpha of fully covered glyph pixels.
+    )
+{
+    const int mask_width = (int)FPF_SUBPIXEL_MASK_WIDTH;
+    const size_t mask_size = FPF_GLYPH_HEIGHT * FPF_SUBPIXEL_MASK_WIDTH;
+
+    const unsigned char *p_phase_masks;
+    int left = (int)x;
+    unsigned int phase;
+    int pen_x;
+    int pen_y = y;
+    size_t glyph_count = 0;
+    size_t i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_draw_text_alpha8_subpixel");
+    FPF_assert(NULL != p_masks);
+    FPF_assert(NULL != p_surface);
+    FPF_assert(NULL != text || 0 == length);
+    FPF_assert(phase_count >= 1 && phase_count <= FPF_MAX_SUBPIXEL_PHASES);
+
+    // Split x into a whole pixel (rounded down) and the nearest phase within it.
+    if ((float)left > x)
+    {
+        --left;
+    }
+    phase = (unsigned int)((x - (float)left) * (float)phase_count + 0.5f);
+    if (phase >= phase_count)
+    {
+        ++left;
+        phase = 0;
+    }
+    p_phase_masks = p_masks + (size_t)phase * FPF_GLYPH_COUNT * mask_size;
+    pen_x = left;
+
+    for (i = 0; i < length; ++i)
+    {
+        const char character = text[i];
+        const unsigned char *p_mask;
+        int first_column;
+        int end_column;
+        int first_row;
+        int end_row;
+        int row; // For loops.
+        int column; // For loops.
+
+        if ('\n' == character)
+        {
+            pen_x = left;
+            pen_y += (int)FPF_GLYPH_HEIGHT;
+            continue;
+        }
+
+        if (' ' == character || '\t' == character ||
+            pen_x >= (int)width || pen_y >= (int)height ||
+            pen_x + mask_width <= 0 || pen_y + (int)FPF_GLYPH_HEIGHT <= 0) // if (nothing to draw)
+        {
+            pen_x += (int)FPF_GLYPH_WIDTH;
+            continue;
+        }
+
+        p_mask = p_phase_masks + fpf_get_glyph_index(character) * mask_size;
+        first_column = (pen_x < 0) ? -pen_x : 0;
+        end_column = (pen_x + mask_width > (int)width) ? (int)width - pen_x : mask_width;
+        first_row = (pen_y < 0) ? -pen_y : 0;
+        end_row = (pen_y + (int)FPF_GLYPH_HEIGHT > (int)height) ? (int)height - pen_y : (int)FPF_GLYPH_HEIGHT;
+
+        if (mask_width == end_column - first_column) // if (whole mask rows are on the surface)
+        {
+            for (row = first_row; row < end_row; ++row)
+            {
+                fpf_blend_subpixel_mask_row(p_surface + (size_t)(pen_y + row) * line_pitch + pen_x,
+                                            p_mask + row * mask_width, alpha);
+            }
+
+            ++glyph_count;
+            pen_x += (int)FPF_GLYPH_WIDTH;
+            continue;
+        }
+
+        // Clipped on the left or right; one pixel at a time.
+        for (row = first_row; row < end_row; ++row)
+        {
+            const unsigned char *const p_src = p_mask + row * mask_width + first_column;
+            unsigned char *const p_dst = p_surface + (size_t)(pen_y + row) * line_pitch + (pen_x + first_column);
+
+            for (column = 0; column < end_column - first_column; ++column)
+            {
+                const unsigned int src = FPF_DIV255(p_src[column] * (unsigned int)alpha);
+
+                if (0 != src)
+                {
+                    p_dst[column] = (unsigned char)(src + FPF_DIV255(p_dst[column] * (255 - src)));
+                }
+            }
+        }
+
+        ++glyph_count;
+        pen_x += (int)FPF_GLYPH_WIDTH;
+    }
+
+    FPF_STAT_ADD(glyphs_emitted, glyph_count);
+    FPF_PROFILE_END("fpf_draw_text_alpha8_subpixel");
+    return glyph_count;
 }
 
 #endif // FPF_IMPLEMENT
@@ -0,0 +1,67 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: atomic operations for the add-on headers
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+//
+//
+
+//
+// Thin wrappers so the thread-safe add-on headers compile as either C11 (<stdatomic.h>) or
+// C++11 (<atomic>). The order argument is one of relaxed, acquire, release, acq_rel or seq_cst.
+//
+
+#ifndef FPF_ATOMIC_H
+#define FPF_ATOMIC_H
+
+#ifdef __cplusplus
+#include <atomic>
+#define FPF_ATOMIC(type) std::atomic<type>
+#define FPF_atomic_load(p, order) std::atomic_load_explicit(p, std::memory_order_##order)
+#define FPF_atomic_store(p, value, order) std::atomic_store_explicit(p, value, std::memory_order_##order)
+#define FPF_atomic_fetch_add(p, value, order) std::atomic_fetch_add_explicit(p, value, std::memory_order_##order)
+#define FPF_atomic_exchange(p, value, order) std::atomic_exchange_explicit(p, value, std::memory_order_##order)
+#define FPF_atomic_compare_exchange_weak(p, p_expected, desired, order) \
+    std::atomic_compare_exchange_weak_explicit(p, p_expected, desired, std::memory_order_##order, std::memory_order_relaxed)
+#define FPF_atomic_thread_fence(order) std::atomic_thread_fence(std::memory_order_##order)
+#else
+#include <stdatomic.h>
+#define FPF_ATOMIC(type) _Atomic type
+#define FPF_atomic_load(p, order) atomic_load_explicit(p, memory_order_##order)
+#define FPF_atomic_store(p, value, order) atomic_store_explicit(p, value, memory_order_##order)
+#define FPF_atomic_fetch_add(p, value, order) atomic_fetch_add_explicit(p, value, memory_order_##order)
+#define FPF_atomic_exchange(p, value, order) atomic_exchange_explicit(p, value, memory_order_##order)
+#define FPF_atomic_compare_exchange_weak(p, p_expected, desired, order) \
+    atomic_compare_exchange_weak_explicit(p, p_expected, desired, memory_order_##order, memory_order_relaxed)
+#define FPF_atomic_thread_fence(order) atomic_thread_fence(memory_order_##order)
+#endif
+
+// Size of a cache line; used to keep data written by different threads from false sharing.
+#ifndef FPF_CACHE_LINE_SIZE
+#define FPF_CACHE_LINE_SIZE 64u
+#endif
+
+#endif // FPF_ATOMIC_H
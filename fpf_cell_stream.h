@@ -0,0 +1,751 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: delta-encoded cell stream
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+//
+//
+
+
+//
+// Mirrors a text console (a grid of 6x6 character cells) over a slow link. The sender keeps
+// drawing into a grid; once per frame the encoder diffs it against the last frame sent and writes
+// only the changes as a compact byte stream: skips over unchanged cells, literal and run-length
+// spans of changed characters, color changes and cursor moves. The receiver's decoder applies the
+// stream to its own copy of the grid, which draws through the usual glyph functions.
+//
+//  1) On the sender (the grid and encoder are big; make them static or allocate them):
+//          static fpf_cell_grid console;
+//          static fpf_cell_encoder encoder;
+//          fpf_init_cell_grid(&console, 80, 25);
+//          fpf_init_cell_encoder(&encoder);
+//
+//  2) Each frame, update the grid and send the changes:
+//          fpf_write_cell_text(&console, 0, 0, STATUS_COLOR, "uptime 00:01:02", 15);
+//          fpf_set_cell_cursor(&console, 15, 0, FPF_BLOCK_CURSOR);
+//          byte_count = fpf_encode_cell_frame(&encoder, &console, buffer, sizeof(buffer));
+//          write(link, buffer, byte_count);
+//
+//  3) On the receiver, feed the decoder whatever has arrived; draw whenever a frame completes:
+//          static fpf_cell_decoder decoder;
+//          fpf_init_cell_decoder(&decoder, PALETTE_SIZE);
+//          ...
+//          result = fpf_decode_cell_stream(&decoder, pending, pending_size, &bytes_used);
+//          (drop bytes_used bytes from pending; keep the rest for when more arrives)
+//          if (FPF_CELL_STREAM_FRAME == result)
+//              vertex_count = fpf_layout_cell_grid(&decoder.grid, 0.0f, 0.0f, palette, FPF_VECTOR_Y_AXIS,
+//                                                  vertices, max_vertices);
+//
+//  Notes: The stream is a series of one-byte opcodes (see FPF_CELL_OP_*); counts and cell indices
+//         are little-endian base-128 varints. Colors are palette indices, so the palette itself
+//         never crosses the link; the decoder rejects colors past the end of the receiver's
+//         palette, so a decoded grid is safe to draw with it. A buffer of FPF_CELL_STREAM_MAX_FRAME_SIZE() bytes holds any
+//         frame. The stream has no framing or checksums of its own; a lossy link needs both.
+//
+
+#ifndef FPF_CELL_STREAM_H
+#define FPF_CELL_STREAM_H
+
+#include <stddef.h> // For size_t.
+#include "five_pixel_font.h"
+
+// #define your own FPF_CELL_GRID_MAX_CELLS to change the largest grid (columns x rows).
+#ifndef FPF_CELL_GRID_MAX_CELLS
+#define FPF_CELL_GRID_MAX_CELLS (132u * 60u)
+#endif
+
+// Stream opcodes. Each frame ends with FPF_CELL_OP_END; the first frame starts with a reset.
+#define FPF_CELL_OP_END     0x00u   // End of frame; the write position and color go back to 0.
+#define FPF_CELL_OP_RESET   0x01u   // Followed by columns and rows (varints); clears the grid to spaces in color 0.
+#define FPF_CELL_OP_SKIP    0x02u   // Followed by a cell count (varint) to move the write position forward.
+#define FPF_CELL_OP_COLOR   0x03u   // Followed by the color of the cells written next.
+#define FPF_CELL_OP_CURSOR  0x04u   // Followed by the cursor's cell index (varint) and style (or FPF_NO_CURSOR).
+#define FPF_CELL_OP_REPEAT  0x40u   // 0x40 + (n - 1), followed by one character: n (1-64) copies of it.
+#define FPF_CELL_OP_TEXT    0x80u   // 0x80 + (n - 1), followed by n (1-128) characters.
+
+// The most bytes a frame of a grid with cell_count cells can take.
+#define FPF_CELL_STREAM_MAX_FRAME_SIZE(cell_count) (32u + 6u * (cell_count))
+
+// Results of fpf_decode_cell_stream().
+#define FPF_CELL_STREAM_ERROR   (-1)    // The stream is malformed.
+#define FPF_CELL_STREAM_MORE    0       // Everything given was applied; the frame isn't finished yet.
+#define FPF_CELL_STREAM_FRAME   1       // A frame was finished (the grid is ready to draw).
+
+// Cursor style of a grid without a cursor.
+#define FPF_NO_CURSOR 0xffu
+
+// A text console as a grid of character cells.
+typedef struct
+{
+    unsigned int    columns;                                // Width of the grid in cells.
+    unsigned int    rows;                                   // Height of the grid in cells.
+    char            characters[FPF_CELL_GRID_MAX_CELLS];    // Character of each cell, a row at a time.
+    unsigned char   colors[FPF_CELL_GRID_MAX_CELLS];        // Color (palette index) of each cell.
+    unsigned int    cursor_cell;                            // Index of the cell under the cursor.
+    unsigned char   cursor_style;                           // fpf_cursor_style of the cursor, or FPF_NO_CURSOR.
+} fpf_cell_grid;
+
+typedef struct
+{
+    fpf_cell_grid   sent;           // The grid as the decoder has it.
+    int             needs_reset;    // Whether the next frame has to start with a reset.
+    size_t          frame_count;    // Frames encoded.
+    size_t          byte_count;     // Bytes encoded.
+} fpf_cell_encoder;
+
+typedef struct
+{
+    fpf_cell_grid   grid;           // The mirrored grid.
+    unsigned int    position;       // Cell the next character is written to.
+    unsigned char   color;          // Color of the next character written.
+    unsigned int    color_count;    // Number of colors in the receiver's palette.
+} fpf_cell_decoder;
+
+// Declarations.
+void fpf_init_cell_grid(fpf_cell_grid *const p_grid, const unsigned int columns, const unsigned int rows);
+void fpf_write_cell_text(fpf_cell_grid *const p_grid, const unsigned int column, const unsigned int row,
+                         const unsigned char color, const char *const text, const size_t length);
+void fpf_set_cell_cursor(fpf_cell_grid *const p_grid, const unsigned int column, const unsigned int row,
+                         const unsigned int cursor_style);
+void fpf_init_cell_encoder(fpf_cell_encoder *const p_encoder);
+size_t fpf_encode_cell_frame(fpf_cell_encoder *const p_encoder, const fpf_cell_grid *const p_frame,
+                             unsigned char *const p_stream, const size_t max_bytes);
+void fpf_init_cell_decoder(fpf_cell_decoder *const p_decoder, const unsigned int color_count);
+int fpf_decode_cell_stream(fpf_cell_decoder *const p_decoder, const unsigned char *const p_stream,
+                           const size_t size, size_t *const p_bytes_used);
+size_t fpf_layout_cell_grid(const fpf_cell_grid *const p_grid, const float x, const float y,
+                            const unsigned int *const p_palette, const fpf_y_axis_direction y_axis_direction,
+                            fpf_vertex *const p_vertices, const size_t max_vertices);
+size_t fpf_draw_cell_grid_alpha8(const fpf_cell_grid *const p_grid, const unsigned char *const p_glyph_bits,
+                                 unsigned char *const p_surface, const unsigned int width, const unsigned int height,
+                                 const size_t line_pitch, const int x, const int y,
+                                 const unsigned char *const p_alphas);
+
+#ifdef FPF_IMPLEMENTATION
+
+// Prepares an empty grid: every cell a space in color 0, and no cursor.
+void fpf_init_cell_grid(
+    fpf_cell_grid *const    p_grid,     // [out] Grid to initialize.
+    const unsigned int      columns,    // [in]  Width of the grid in cells.
+    const unsigned int      rows        // [in]  Height of the grid in cells.
+    )
+{
+    FPF_assert(NULL != p_grid);
+    FPF_assert(columns * rows <= FPF_CELL_GRID_MAX_CELLS);
+
+    p_grid->columns = columns;
+    p_grid->rows = rows;
+    FPF_memset(p_grid->characters, ' ', columns * rows);
+    FPF_memset(p_grid->colors, 0, columns * rows);
+    p_grid->cursor_cell = 0;
+    p_grid->cursor_style = FPF_NO_CURSOR;
+}
+
+// Writes text into a grid, starting at a cell. A newline continues at the starting column of the
+// next row; text past the right or bottom edge is cut.
+void fpf_write_cell_text(
+    fpf_cell_grid *const    p_grid, // [in/out] Grid to write to.
+    const unsigned int      column, // [in]     Column of the first character.
+    const unsigned int      row,    // [in]     Row of the first character.
+    const unsigned char     color,  // [in]     Color (palette index) of the text.
+    const char *const       text,   // [in]     Text to write.
+    const size_t            length  // [in]     Number of characters in the text.
+    )
+{
+    unsigned int x = column;
+    unsigned int y = row;
+    size_t i; // For loops.
+
+    FPF_assert(NULL != p_grid);
+    FPF_assert(NULL != text || 0 == length);
+
+    for (i = 0; i < length && y < p_grid->rows; ++i)
+    {
+        if ('\n' == text[i])
+        {
+            x = column;
+            ++y;
+            continue;
+        }
+
+        if (x < p_grid->columns)
+        {
+            p_grid->characters[y * p_grid->columns + x] = text[i];
+            p_grid->colors[y * p_grid->columns + x] = color;
+        }
+
+        ++x;
+    }
+}
+
+// Moves (or hides) a grid's cursor.
+void fpf_set_cell_cursor(
+    fpf_cell_grid *const    p_grid,         // [in/out] Grid to change.
+    const unsigned int      column,         // [in]     Column of the cursor.
+    const unsigned int      row,            // [in]     Row of the cursor.
+    const unsigned int      cursor_style    // [in]     fpf_cursor_style of the cursor, or FPF_NO_CURSOR to hide it.
+    )
+{
+    FPF_assert(NULL != p_grid);
+    FPF_assert(column < p_grid->columns && row < p_grid->rows);
+    FPF_assert(cursor_style <= FPF_VERTICAL_CURSOR || FPF_NO_CURSOR == cursor_style);
+
+    p_grid->cursor_cell = row * p_grid->columns + column;
+    p_grid->cursor_style = (unsigned char)cursor_style;
+}
+
+// Prepares an encoder; its first frame resets the decoder.
+void fpf_init_cell_encoder(
+    fpf_cell_encoder *const p_encoder   // [out] Encoder to initialize.
+    )
+{
+    FPF_assert(NULL != p_encoder);
+
+    fpf_init_cell_grid(&p_encoder->sent, 0, 0);
+    p_encoder->needs_reset = 1;
+    p_encoder->frame_count = 0;
+    p_encoder->byte_count = 0;
+}
+
+// Writes a varint; returns the number of bytes written (at most 5).
+size_t fpf_write_cell_varint(
+    unsigned char *const    p_stream,   // [out] Where to write.
+    unsigned int            value       // [in]  Value to write.
+    )
+{
+    size_t byte_count = 0;
+
+    while (value >= 0x80)
+    {
+        p_stream[byte_count++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+
+    p_stream[byte_count++] = (unsigned char)value;
+    return byte_count;
+}
+
+// Counts the cells from index on with the same character and color as that cell.
+unsigned int fpf_get_cell_run_length(
+    const fpf_cell_grid *const  p_frame,    // [in] Grid to look at.
+    const unsigned int          index,      // [in] First cell of the run.
+    const unsigned int          end,        // [in] One past the last cell the run may take.
+    const unsigned int          max_length  // [in] Longest run to count.
+    )
+{
+    unsigned int length = 1;
+
+    while (index + length < end && length < max_length &&
+           p_frame->characters[index + length] == p_frame->characters[index] &&
+           p_frame->colors[index + length] == p_frame->colors[index])
+    {
+        ++length;
+    }
+
+    return length;
+}
+
+// Encodes the changes since the last frame encoded (or the whole grid, the first time and
+// whenever its size changes).
+// Returns: the number of bytes written, or 0 if max_bytes is less than
+//          FPF_CELL_STREAM_MAX_FRAME_SIZE(columns * rows) (nothing is encoded in that case).
+size_t fpf_encode_cell_frame(
+    fpf_cell_encoder *const     p_encoder,  // [in/out] Encoder state.
+    const fpf_cell_grid *const  p_frame,    // [in]     Grid to send.
+    unsigned char *const        p_stream,   // [out]    Where to write the encoded frame.
+    const size_t                max_bytes   // [in]     Capacity of the stream buffer in bytes.
+    )
+{
+    // Unchanged gaps this short are cheaper to resend than to skip.
+    const unsigned int max_gap = 2;
+    const unsigned int cell_count = p_frame->columns * p_frame->rows;
+    fpf_cell_grid *const p_sent = &p_encoder->sent;
+    size_t byte_count = 0;
+    unsigned int position = 0; // The decoder's write position.
+    unsigned char color = 0; // The decoder's color.
+    unsigned int i = 0;
+
+    FPF_PROFILE_BEGIN("fpf_encode_cell_frame");
+    FPF_assert(NULL != p_encoder);
+    FPF_assert(NULL != p_frame);
+    FPF_assert(NULL != p_stream);
+
+    if (max_bytes < FPF_CELL_STREAM_MAX_FRAME_SIZE(cell_count))
+    {
+        FPF_PROFILE_END("fpf_encode_cell_frame");
+        return 0;
+    }
+
+    if (p_encoder->needs_reset || p_sent->columns != p_frame->columns || p_sent->rows != p_frame->rows)
+    {
+        p_stream[byte_count++] = FPF_CELL_OP_RESET;
+        byte_count += fpf_write_cell_varint(&p_stream[byte_count], p_frame->columns);
+        byte_count += fpf_write_cell_varint(&p_stream[byte_count], p_frame->rows);
+        fpf_init_cell_grid(p_sent, p_frame->columns, p_frame->rows);
+        p_encoder->needs_reset = 0;
+    }
+
+    while (i < cell_count)
+    {
+        unsigned int end;
+        unsigned int j; // For loops.
+
+        if (p_frame->characters[i] == p_sent->characters[i] && p_frame->colors[i] == p_sent->colors[i])
+        {
+            ++i;
+            continue;
+        }
+
+        // Find the end of the changed span, bridging short unchanged gaps.
+        end = i + 1;
+        for (j = end; j < cell_count && j - end <= max_gap; ++j)
+        {
+            if (p_frame->characters[j] != p_sent->characters[j] || p_frame->colors[j] != p_sent->colors[j])
+            {
+                end = j + 1;
+            }
+        }
+
+        if (i > position)
+        {
+            p_stream[byte_count++] = FPF_CELL_OP_SKIP;
+            byte_count += fpf_write_cell_varint(&p_stream[byte_count], i - position);
+        }
+
+        // Write the span as color changes, runs and literal text.
+        while (i < end)
+        {
+            unsigned int start;
+
+            if (p_frame->colors[i] != color)
+            {
+                color = p_frame->colors[i];
+                p_stream[byte_count++] = FPF_CELL_OP_COLOR;
+                p_stream[byte_count++] = color;
+            }
+
+            j = fpf_get_cell_run_length(p_frame, i, end, 64);
+            if (j >= 3) // if (a run is shorter than the same text)
+            {
+                p_stream[byte_count++] = (unsigned char)(FPF_CELL_OP_REPEAT + j - 1);
+                p_stream[byte_count++] = (unsigned char)p_frame->characters[i];
+                i += j;
+                continue;
+            }
+
+            // Literal text up to the next color change or run.
+            start = i;
+            do
+            {
+                ++i;
+            } while (i < end && i - start < 128 && p_frame->colors[i] == color && fpf_get_cell_run_length(p_frame, i, end, 3) < 3);
+
+            p_stream[byte_count++] = (unsigned char)(FPF_CELL_OP_TEXT + (i - start) - 1);
+            FPF_memcpy(&p_stream[byte_count], &p_frame->characters[start], i - start);
+            byte_count += i - start;
+        }
+
+        position = end;
+    }
+
+    if (p_frame->cursor_cell != p_sent->cursor_cell || p_frame->cursor_style != p_sent->cursor_style)
+    {
+        p_stream[byte_count++] = FPF_CELL_OP_CURSOR;
+        byte_count += fpf_write_cell_varint(&p_stream[byte_count], p_frame->cursor_cell);
+        p_stream[byte_count++] = p_frame->cursor_style;
+    }
+
+    p_stream[byte_count++] = FPF_CELL_OP_END;
+
+    // Remember what the decoder will have.
+    FPF_memcpy(p_sent->characters, p_frame->characters, cell_count);
+    FPF_memcpy(p_sent->colors, p_frame->colors, cell_count);
+    p_sent->cursor_cell = p_frame->cursor_cell;
+    p_sent->cursor_style = p_frame->cursor_style;
+
+    ++p_encoder->frame_count;
+    p_encoder->byte_count += byte_count;
+    FPF_PROFILE_END("fpf_encode_cell_frame");
+    return byte_count;
+}
+
+// Prepares a decoder. Its grid is empty (0 x 0) until the stream's first reset. Colors at or
+// past color_count are rejected as malformed, since they'd index past the end of the palette.
+void fpf_init_cell_decoder(
+    fpf_cell_decoder *const p_decoder,  // [out] Decoder to initialize.
+    const unsigned int      color_count // [in]  Number of colors in the palette it's drawn with (1 to 256).
+    )
+{
+    FPF_assert(NULL != p_decoder);
+    FPF_assert(color_count >= 1 && color_count <= 256);
+
+    fpf_init_cell_grid(&p_decoder->grid, 0, 0);
+    p_decoder->position = 0;
+    p_decoder->color = 0;
+    p_decoder->color_count = color_count;
+}
+
+// Reads a varint; returns the number of bytes read, or 0 if it's cut off (or too long).
+size_t fpf_read_cell_varint(
+    const unsigned char *const  p_stream,   // [in]  Where to read.
+    const size_t                size,       // [in]  Bytes available.
+    unsigned int *const         p_value     // [out] Value read.
+    )
+{
+    unsigned int value = 0;
+    size_t i; // For loops.
+
+    for (i = 0; i < size && i < 5; ++i)
+    {
+        value |= (unsigned int)(p_stream[i] & 0x7f) << (7 * i);
+
+        if (0 == (p_stream[i] & 0x80))
+        {
+            *p_value = value;
+            return i + 1;
+        }
+    }
+
+    return 0;
+}
+
+// Applies as much of a stream as is there, stopping at the end of a frame. An opcode cut off at
+// the end of the data isn't applied; pass its bytes again once the rest has arrived.
+// Returns: FPF_CELL_STREAM_FRAME if a frame was finished (call again for any data after it),
+//          FPF_CELL_STREAM_MORE if all of the data was used without finishing a frame, or
+//          FPF_CELL_STREAM_ERROR if the stream is malformed.
+int fpf_decode_cell_stream(
+    fpf_cell_decoder *const     p_decoder,      // [in/out] Decoder state.
+    const unsigned char *const  p_stream,       // [in]     Stream data received.
+    const size_t                size,           // [in]     Number of bytes received.
+    size_t *const               p_bytes_used    // [out]    Number of bytes applied.
+    )
+{
+    fpf_cell_grid *const p_grid = &p_decoder->grid;
+    size_t used = 0;
+    int result = FPF_CELL_STREAM_MORE;
+
+    FPF_PROFILE_BEGIN("fpf_decode_cell_stream");
+    FPF_assert(NULL != p_decoder);
+    FPF_assert(NULL != p_stream || 0 == size);
+    FPF_assert(NULL != p_bytes_used);
+
+    while (used < size)
+    {
+        const unsigned char opcode = p_stream[used];
+        const unsigned char *const p_operands = &p_stream[used + 1];
+        const size_t available = size - used - 1;
+        const unsigned int cell_count = p_grid->columns * p_grid->rows;
+        unsigned int first;
+        unsigned int second;
+        size_t length;
+        size_t second_length;
+
+        if (opcode >= FPF_CELL_OP_REPEAT) // Text or repeat.
+        {
+            const int is_text = (opcode >= FPF_CELL_OP_TEXT);
+            const unsigned int count = opcode - (is_text ? FPF_CELL_OP_TEXT : FPF_CELL_OP_REPEAT) + 1;
+            const size_t operand_size = is_text ? count : 1;
+
+            if (available < operand_size)
+            {
+                break;
+            }
+
+            if (count > cell_count - p_decoder->position)
+            {
+                result = FPF_CELL_STREAM_ERROR;
+                break;
+            }
+
+            if (is_text)
+            {
+                FPF_memcpy(&p_grid->characters[p_decoder->position], p_operands, count);
+            }
+            else
+            {
+                FPF_memset(&p_grid->characters[p_decoder->position], p_operands[0], count);
+            }
+
+            FPF_memset(&p_grid->colors[p_decoder->position], p_decoder->color, count);
+            p_decoder->position += count;
+            used += 1 + operand_size;
+            continue;
+        }
+
+        switch (opcode)
+        {
+        case FPF_CELL_OP_END:
+            p_decoder->position = 0;
+            p_decoder->color = 0;
+            used += 1;
+            result = FPF_CELL_STREAM_FRAME;
+            break;
+
+        case FPF_CELL_OP_RESET:
+            length = fpf_read_cell_varint(p_operands, available, &first);
+            second_length = (0 != length) ? fpf_read_cell_varint(&p_operands[length], available - length, &second) : 0;
+            if (0 == second_length)
+            {
+                result = (available >= 10) ? FPF_CELL_STREAM_ERROR : FPF_CELL_STREAM_MORE;
+                break;
+            }
+
+            if (first > FPF_CELL_GRID_MAX_CELLS || second > FPF_CELL_GRID_MAX_CELLS ||
+                first * second > FPF_CELL_GRID_MAX_CELLS)
+            {
+                result = FPF_CELL_STREAM_ERROR;
+                break;
+            }
+
+            fpf_init_cell_grid(p_grid, first, second);
+            p_decoder->position = 0;
+            p_decoder->color = 0;
+            used += 1 + length + second_length;
+            continue;
+
+        case FPF_CELL_OP_SKIP:
+            length = fpf_read_cell_varint(p_operands, available, &first);
+            if (0 == length)
+            {
+                result = (available >= 5) ? FPF_CELL_STREAM_ERROR : FPF_CELL_STREAM_MORE;
+                break;
+            }
+
+            if (first > cell_count - p_decoder->position)
+            {
+                result = FPF_CELL_STREAM_ERROR;
+                break;
+            }
+
+            p_decoder->position += first;
+            used += 1 + length;
+            continue;
+
+        case FPF_CELL_OP_COLOR:
+            if (available < 1)
+            {
+                break;
+            }
+
+            if (p_operands[0] >= p_decoder->color_count)
+            {
+                result = FPF_CELL_STREAM_ERROR;
+                break;
+            }
+
+            p_decoder->color = p_operands[0];
+            used += 2;
+            continue;
+
+        case FPF_CELL_OP_CURSOR:
+            length = fpf_read_cell_varint(p_operands, available, &first);
+            if (0 == length || available < length + 1)
+            {
+                result = (available >= 6) ? FPF_CELL_STREAM_ERROR : FPF_CELL_STREAM_MORE;
+                break;
+            }
+
+            second = p_operands[length];
+            if ((first >= cell_count && FPF_NO_CURSOR != second) ||
+                (second > FPF_VERTICAL_CURSOR && FPF_NO_CURSOR != second))
+            {
+                result = FPF_CELL_STREAM_ERROR;
+                break;
+            }
+
+            p_grid->cursor_cell = first;
+            p_grid->cursor_style = (unsigned char)second;
+            used += 1 + length + 1;
+            continue;
+
+        default:
+            result = FPF_CELL_STREAM_ERROR;
+            break;
+        }
+
+        break;
+    }
+
+    *p_bytes_used = used;
+    FPF_PROFILE_END("fpf_decode_cell_stream");
+    return result;
+}
+
+// Lays out a grid as one batch of glyph quads (see fpf_layout_text()), cursor last. Text that
+// doesn't fit in the vertex buffer is cut off. The palette needs an entry for every color in the
+// grid (a decoder's grid only holds colors below its color_count).
+// Returns: the number of vertices written.
+size_t fpf_layout_cell_grid(
+    const fpf_cell_grid *const  p_grid,             // [in]  Grid to lay out.
+    const float                 x,                  // [in]  Left edge of the grid in pixels.
+    const float                 y,                  // [in]  Top edge of the grid in pixels.
+    const unsigned int *const   p_palette,          // [in]  Vertex color of each palette index, or NULL for all 0xffffffff.
+    const fpf_y_axis_direction  y_axis_direction,   // [in]  Direction of the texture's y-axis.
+    fpf_vertex *const           p_vertices,         // [out] Vertex buffer to fill.
+    const size_t                max_vertices        // [in]  Capacity of the vertex buffer in vertices.
+    )
+{
+    size_t vertex_count = 0;
+    unsigned int row; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_layout_cell_grid");
+    FPF_assert(NULL != p_grid);
+    FPF_assert(NULL != p_vertices || 0 == max_vertices);
+
+    for (row = 0; row < p_grid->rows; ++row)
+    {
+        const unsigned int row_start = row * p_grid->columns;
+        unsigned int start = 0;
+
+        // Lay out each run of one color in one call.
+        while (start < p_grid->columns)
+        {
+            const unsigned char color = p_grid->colors[row_start + start];
+            unsigned int end = start + 1;
+
+            while (end < p_grid->columns && p_grid->colors[row_start + end] == color)
+            {
+                ++end;
+            }
+
+            vertex_count += fpf_layout_text(&p_grid->characters[row_start + start], end - start,
+                                            x + (float)(start * FPF_GLYPH_WIDTH), y + (float)(row * FPF_GLYPH_HEIGHT),
+                                            (NULL != p_palette) ? p_palette[color] : 0xffffffffu, y_axis_direction,
+                                            &p_vertices[vertex_count], max_vertices - vertex_count);
+            start = end;
+        }
+    }
+
+    if (FPF_NO_CURSOR != p_grid->cursor_style && vertex_count + FPF_VERTICES_PER_GLYPH <= max_vertices)
+    {
+        const float left_edge = x + (float)((p_grid->cursor_cell % p_grid->columns) * FPF_GLYPH_WIDTH);
+        const float top_edge = y + (float)((p_grid->cursor_cell / p_grid->columns) * FPF_GLYPH_HEIGHT);
+        const unsigned char color = p_grid->colors[p_grid->cursor_cell];
+        float left;
+        float top;
+        float right;
+        float bottom;
+
+        if (FPF_RASTER_Y_AXIS == y_axis_direction)
+        {
+            fpf_get_cursor_glyph_dx_texture_coordinates((fpf_cursor_style)p_grid->cursor_style, &left, &top, &right, &bottom);
+        }
+        else
+        {
+            fpf_get_cursor_glyph_gl_texture_coordinates((fpf_cursor_style)p_grid->cursor_style, &left, &top, &right, &bottom);
+        }
+
+        fpf_emit_quad(&p_vertices[vertex_count], left_edge, top_edge, left_edge + FPF_GLYPH_WIDTH,
+                      top_edge + FPF_GLYPH_HEIGHT, left, top, right, bottom,
+                      (NULL != p_palette) ? p_palette[color] : 0xffffffffu);
+        vertex_count += FPF_VERTICES_PER_GLYPH;
+    }
+
+    FPF_PROFILE_END("fpf_layout_cell_grid");
+    return vertex_count;
+}
+
+// Draws a grid into an 8-bit surface in software (see fpf_draw_text_alpha8()), cursor last. The
+// alpha table needs an entry for every color in the grid (a decoder's grid only holds colors
+// below its color_count).
+// Returns: the number of glyphs drawn, cursor included.
+size_t fpf_draw_cell_grid_alpha8(
+    const fpf_cell_grid *const  p_grid,         // [in]     Grid to draw.
+    const unsigned char *const  p_glyph_bits,   // [in]     Glyph bits from fpf_create_glyph_bits().
+    unsigned char *const        p_surface,      // [in/out] Surface to draw on; first byte is the top-left pixel.
+    const unsigned int          width,          // [in]     Width of the surface in pixels.
+    const unsigned int          height,         // [in]     Height of the surface in pixels.
+    const size_t                line_pitch,     // [in]     Line pitch of the surface in bytes.
+    const int                   x,              // [in]     Left edge of the grid in pixels.
+    const int                   y,              // [in]     Top edge of the grid in pixels.
+    const unsigned char *const  p_alphas        // [in]     Value written for glyph pixels of each palette index, or NULL for all 0xff.
+    )
+{
+    size_t glyph_count = 0;
+    unsigned int row; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_draw_cell_grid_alpha8");
+    FPF_assert(NULL != p_grid);
+
+    for (row = 0; row < p_grid->rows; ++row)
+    {
+        const unsigned int row_start = row * p_grid->columns;
+        unsigned int start = 0;
+
+        while (start < p_grid->columns)
+        {
+            const unsigned char color = p_grid->colors[row_start + start];
+            unsigned int end = start + 1;
+
+            while (end < p_grid->columns && p_grid->colors[row_start + end] == color)
+            {
+                ++end;
+            }
+
+            glyph_count += fpf_draw_text_alpha8(p_glyph_bits, p_surface, width, height, line_pitch,
+                                                x + (int)(start * FPF_GLYPH_WIDTH), y + (int)(row * FPF_GLYPH_HEIGHT),
+                                                &p_grid->characters[row_start + start], end - start,
+                                                (NULL != p_alphas) ? p_alphas[color] : 0xff);
+            start = end;
+        }
+    }
+
+    if (FPF_NO_CURSOR != p_grid->cursor_style)
+    {
+        const unsigned char *const p_rows =
+            &p_glyph_bits[fpf_get_cursor_glyph_index((fpf_cursor_style)p_grid->cursor_style) * FPF_GLYPH_HEIGHT];
+        const int pen_x = x + (int)((p_grid->cursor_cell % p_grid->columns) * FPF_GLYPH_WIDTH);
+        const int pen_y = y + (int)((p_grid->cursor_cell / p_grid->columns) * FPF_GLYPH_HEIGHT);
+        const unsigned char alpha = (NULL != p_alphas) ? p_alphas[p_grid->colors[p_grid->cursor_cell]] : 0xff;
+        int row_y; // For loops.
+        int column; // For loops.
+
+        for (row_y = 0; row_y < (int)FPF_GLYPH_HEIGHT; ++row_y)
+        {
+            for (column = 0; column < (int)FPF_GLYPH_WIDTH; ++column)
+            {
+                const int pixel_x = pen_x + column;
+                const int pixel_y = pen_y + row_y;
+
+                if ((p_rows[row_y] & (0x80u >> column)) && pixel_x >= 0 && pixel_x < (int)width &&
+                    pixel_y >= 0 && pixel_y < (int)height)
+                {
+                    p_surface[pixel_y * line_pitch + pixel_x] = alpha;
+                }
+            }
+        }
+
+        ++glyph_count;
+    }
+
+    FPF_PROFILE_END("fpf_draw_cell_grid_alpha8");
+    return glyph_count;
+}
+
+#endif // FPF_IMPLEMENTATION
+
+#endif // FPF_CELL_STREAM_H
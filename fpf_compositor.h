@@ -0,0 +1,401 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: tile-binned multithreaded compositor
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+//
+//
+
+//
+// Draws many blocks of text onto one 8-bit alpha surface from several threads at once. The
+// surface is cut into square tiles; every draw command is binned into the tiles its text box
+// touches, then worker threads render whole tiles, each tile clipped to itself. No two threads
+// ever write the same pixel, no locks are taken, and the commands in a tile are drawn in the
+// order they were submitted, so the result is bit-identical to drawing them one after another
+// with fpf_draw_text_alpha8().
+//
+//  1) Build the list of commands for the frame:
+//          commands[i].x = 10; commands[i].y = 10; commands[i].alpha = 0xff;
+//          commands[i].text = "job 42: 1.3 ms"; commands[i].length = 14;
+//
+//  2) Bin them (the compositor is big; make it static or allocate it):
+//          static fpf_compositor compositor;
+//          fpf_begin_composite(&compositor, glyph_bits, surface, width, height, pitch,
+//                              commands, command_count, worker_count);
+//
+//  3) On each of worker_count threads (worker_index 0 .. worker_count - 1), then join them:
+//          fpf_composite_tiles(&compositor, worker_index);
+//
+//  4) Finish on one thread:
+//          glyph_count = fpf_end_composite(&compositor);
+//
+//  Notes: Each worker starts on its own contiguous run of tiles, then steals tiles from the
+//         other workers' runs until none are left, so a worker that never runs (or runs late)
+//         only costs time. Calling fpf_composite_tiles(&compositor, 0) alone is the
+//         single-threaded path. The command text isn't copied; it must outlive the composite.
+//         The workers never touch the (unsynchronized) FPF_STATS counters; each keeps its own
+//         glyph count, and fpf_end_composite() adds them up on one thread.
+//         Compiles as C11 (<stdatomic.h>) or C++11 (<atomic>).
+//
+
+#ifndef FPF_COMPOSITOR_H
+#define FPF_COMPOSITOR_H
+
+#include <stddef.h> // For size_t.
+#include "five_pixel_font.h"
+#include "fpf_atomic.h"
+
+// #define your own FPF_COMPOSITOR_TILE_SIZE to change the width and height of a tile in pixels.
+#ifndef FPF_COMPOSITOR_TILE_SIZE
+#define FPF_COMPOSITOR_TILE_SIZE 64u
+#endif
+
+// #define your own FPF_COMPOSITOR_MAX_TILES to change the largest surface (in tiles) that can be composited.
+#ifndef FPF_COMPOSITOR_MAX_TILES
+#define FPF_COMPOSITOR_MAX_TILES 4096u // 3840x2160 is 60x34 tiles.
+#endif
+
+// #define your own FPF_COMPOSITOR_MAX_COMMANDS to change the number of draw commands per composite.
+#ifndef FPF_COMPOSITOR_MAX_COMMANDS
+#define FPF_COMPOSITOR_MAX_COMMANDS 4096u
+#endif
+
+// #define your own FPF_COMPOSITOR_MAX_BIN_ENTRIES to change the number of (tile, command) pairs per composite.
+#ifndef FPF_COMPOSITOR_MAX_BIN_ENTRIES
+#define FPF_COMPOSITOR_MAX_BIN_ENTRIES 32768u
+#endif
+
+// #define your own FPF_COMPOSITOR_MAX_WORKERS to change the number of threads that can share a composite.
+#ifndef FPF_COMPOSITOR_MAX_WORKERS
+#define FPF_COMPOSITOR_MAX_WORKERS 64u
+#endif
+
+// Returned by fpf_begin_composite() when the surface has more than FPF_COMPOSITOR_MAX_TILES tiles
+// or there are more than FPF_COMPOSITOR_MAX_COMMANDS commands.
+#define FPF_COMPOSITE_TOO_LARGE ((size_t)-1)
+
+// A block of text to draw; newlines start a new line of text.
+typedef struct
+{
+    int             x;          // Left edge of the text in pixels.
+    int             y;          // Top edge of the text in pixels.
+    const char     *text;       // Text to draw (not copied).
+    size_t          length;     // Number of characters in the text.
+    unsigned char   alpha;      // Value written for glyph pixels.
+} fpf_draw_command;
+
+// A worker's run of tiles. Any worker may take the next tile, so runs sit on separate cache lines.
+typedef struct
+{
+    FPF_ATOMIC(size_t)  next_tile;      // Next tile of the run to render.
+    size_t              end_tile;       // One past the last tile of the run.
+    size_t              glyph_count;    // Glyphs drawn by the run's worker (written once, when it's done).
+    char                padding[FPF_CACHE_LINE_SIZE - 3 * sizeof(size_t)];
+} fpf_compositor_run;
+
+typedef struct
+{
+    const unsigned char    *p_glyph_bits;
+    unsigned char          *p_surface;
+    unsigned int            width;
+    unsigned int            height;
+    size_t                  line_pitch;
+    const fpf_draw_command *p_commands;
+    unsigned int            tiles_across;
+    unsigned int            worker_count;
+    unsigned int            command_tiles[FPF_COMPOSITOR_MAX_COMMANDS][4];  // Left, top, right, bottom tile of each command (exclusive).
+    unsigned int            bin_starts[FPF_COMPOSITOR_MAX_TILES + 1];       // Tile t draws bin_commands[bin_starts[t]] .. bin_commands[bin_starts[t + 1] - 1].
+    unsigned int            bin_commands[FPF_COMPOSITOR_MAX_BIN_ENTRIES];   // Command indices, in submission order within each tile.
+    fpf_compositor_run      runs[FPF_COMPOSITOR_MAX_WORKERS];
+} fpf_compositor;
+
+// Declarations.
+size_t fpf_begin_composite(fpf_compositor *const p_compositor, const unsigned char *const p_glyph_bits,
+                           unsigned char *const p_surface, const unsigned int width, const unsigned int height,
+                           const size_t line_pitch, const fpf_draw_command *const p_commands,
+                           const size_t command_count, const unsigned int worker_count);
+size_t fpf_composite_tiles(fpf_compositor *const p_compositor, const unsigned int worker_index);
+size_t fpf_end_composite(fpf_compositor *const p_compositor);
+
+#ifdef FPF_IMPLEMENTATION
+
+// Finds the tiles a command's text box touches; returns 0 if it's entirely off the surface.
+int fpf_get_command_tiles(
+    const fpf_draw_command *const   p_command,  // [in]  Command to place.
+    const unsigned int              width,      // [in]  Width of the surface in pixels.
+    const unsigned int              height,     // [in]  Height of the surface in pixels.
+    unsigned int *const             p_tiles     // [out] Left, top, right, bottom tile (right and bottom exclusive).
+    )
+{
+    size_t line_start = 0;
+    size_t widest_line = 0;
+    size_t line_count = 0;
+    long left;
+    long top;
+    long right;
+    long bottom;
+
+    // Measure the text box: the longest line by the number of lines.
+    while (line_start < p_command->length)
+    {
+        const char *const p_newline = (const char*)FPF_memchr(&p_command->text[line_start], '\n',
+                                                              p_command->length - line_start);
+        const size_t line_end = (NULL != p_newline) ? (size_t)(p_newline - p_command->text) : p_command->length;
+
+        widest_line = (line_end - line_start > widest_line) ? line_end - line_start : widest_line;
+        ++line_count;
+        line_start = line_end + 1;
+    }
+
+    left = (p_command->x > 0) ? p_command->x : 0;
+    top = (p_command->y > 0) ? p_command->y : 0;
+    right = (long)p_command->x + (long)(widest_line * FPF_GLYPH_WIDTH);
+    bottom = (long)p_command->y + (long)(line_count * FPF_GLYPH_HEIGHT);
+    right = (right < (long)width) ? right : (long)width;
+    bottom = (bottom < (long)height) ? bottom : (long)height;
+
+    if (left >= right || top >= bottom)
+    {
+        return 0;
+    }
+
+    p_tiles[0] = (unsigned int)left / FPF_COMPOSITOR_TILE_SIZE;
+    p_tiles[1] = (unsigned int)top / FPF_COMPOSITOR_TILE_SIZE;
+    p_tiles[2] = ((unsigned int)right + FPF_COMPOSITOR_TILE_SIZE - 1) / FPF_COMPOSITOR_TILE_SIZE;
+    p_tiles[3] = ((unsigned int)bottom + FPF_COMPOSITOR_TILE_SIZE - 1) / FPF_COMPOSITOR_TILE_SIZE;
+    return 1;
+}
+
+// Bins a frame's draw commands into tiles and splits the tiles between the workers. Call it on
+// one thread before starting the workers; the workers may then run fpf_composite_tiles().
+// Returns: 0 on success, FPF_COMPOSITE_TOO_LARGE if the surface or command list is over its limit,
+//          otherwise the number of bin entries required (see FPF_COMPOSITOR_MAX_BIN_ENTRIES).
+//          Nothing is drawn unless it succeeds.
+size_t fpf_begin_composite(
+    fpf_compositor *const           p_compositor,   // [out] Compositor to prepare.
+    const unsigned char *const      p_glyph_bits,   // [in]  Glyph bits from fpf_create_glyph_bits().
+    unsigned char *const            p_surface,      // [in]  Surface to draw on; first byte is the top-left pixel.
+    const unsigned int              width,          // [in]  Width of the surface in pixels.
+    const unsigned int              height,         // [in]  Height of the surface in pixels.
+    const size_t                    line_pitch,     // [in]  Line pitch of the surface in bytes.
+    const fpf_draw_command *const   p_commands,     // [in]  Commands to draw, in drawing order.
+    const size_t                    command_count,  // [in]  Number of commands.
+    const unsigned int              worker_count    // [in]  Number of threads that will run fpf_composite_tiles().
+    )
+{
+    const unsigned int tiles_across = (width + FPF_COMPOSITOR_TILE_SIZE - 1) / FPF_COMPOSITOR_TILE_SIZE;
+    const unsigned int tiles_down = (height + FPF_COMPOSITOR_TILE_SIZE - 1) / FPF_COMPOSITOR_TILE_SIZE;
+    const size_t tile_count = (size_t)tiles_across * tiles_down;
+    size_t entry_count = 0;
+    size_t i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_begin_composite");
+    FPF_assert(NULL != p_compositor);
+    FPF_assert(NULL != p_glyph_bits);
+    FPF_assert(NULL != p_surface);
+    FPF_assert(NULL != p_commands || 0 == command_count);
+    FPF_assert(0 < worker_count && worker_count <= FPF_COMPOSITOR_MAX_WORKERS);
+
+    if (command_count > FPF_COMPOSITOR_MAX_COMMANDS || tile_count > FPF_COMPOSITOR_MAX_TILES)
+    {
+        p_compositor->worker_count = 0;
+        FPF_PROFILE_END("fpf_begin_composite");
+        return FPF_COMPOSITE_TOO_LARGE;
+    }
+
+    p_compositor->p_glyph_bits = p_glyph_bits;
+    p_compositor->p_surface = p_surface;
+    p_compositor->width = width;
+    p_compositor->height = height;
+    p_compositor->line_pitch = line_pitch;
+    p_compositor->p_commands = p_commands;
+    p_compositor->tiles_across = tiles_across;
+    p_compositor->worker_count = worker_count;
+
+    // Count the commands in each tile (a counting sort keeps each bin in submission order).
+    FPF_memset(p_compositor->bin_starts, 0, (tile_count + 1) * sizeof(p_compositor->bin_starts[0]));
+
+    for (i = 0; i < command_count; ++i)
+    {
+        unsigned int *const p_tiles = p_compositor->command_tiles[i];
+        unsigned int tile_x; // For loops.
+        unsigned int tile_y; // For loops.
+
+        if (!fpf_get_command_tiles(&p_commands[i], width, height, p_tiles))
+        {
+            p_tiles[0] = p_tiles[1] = p_tiles[2] = p_tiles[3] = 0;
+            continue;
+        }
+
+        for (tile_y = p_tiles[1]; tile_y < p_tiles[3]; ++tile_y)
+        {
+            for (tile_x = p_tiles[0]; tile_x < p_tiles[2]; ++tile_x)
+            {
+                ++p_compositor->bin_starts[tile_y * tiles_across + tile_x + 1];
+            }
+        }
+
+        entry_count += (size_t)(p_tiles[2] - p_tiles[0]) * (p_tiles[3] - p_tiles[1]);
+    }
+
+    if (entry_count > FPF_COMPOSITOR_MAX_BIN_ENTRIES)
+    {
+        p_compositor->worker_count = 0;
+        FPF_PROFILE_END("fpf_begin_composite");
+        return entry_count;
+    }
+
+    // Turn the counts into bin starts, then fill the bins, using bin_starts[t] as tile t's cursor.
+    for (i = 1; i <= tile_count; ++i)
+    {
+        p_compositor->bin_starts[i] += p_compositor->bin_starts[i - 1];
+    }
+
+    for (i = 0; i < command_count; ++i)
+    {
+        const unsigned int *const p_tiles = p_compositor->command_tiles[i];
+        unsigned int tile_x; // For loops.
+        unsigned int tile_y; // For loops.
+
+        for (tile_y = p_tiles[1]; tile_y < p_tiles[3]; ++tile_y)
+        {
+            for (tile_x = p_tiles[0]; tile_x < p_tiles[2]; ++tile_x)
+            {
+                unsigned int *const p_cursor = &p_compositor->bin_starts[tile_y * tiles_across + tile_x];
+
+                p_compositor->bin_commands[*p_cursor] = (unsigned int)i;
+                ++*p_cursor;
+            }
+        }
+    }
+
+    // Filling advanced each cursor to the end of its bin, which is the next bin's start; shift back.
+    for (i = tile_count; i > 0; --i)
+    {
+        p_compositor->bin_starts[i] = p_compositor->bin_starts[i - 1];
+    }
+
+    p_compositor->bin_starts[0] = 0;
+
+    // Give each worker an even, contiguous run of tiles.
+    for (i = 0; i < worker_count; ++i)
+    {
+        FPF_atomic_store(&p_compositor->runs[i].next_tile, tile_count * i / worker_count, relaxed);
+        p_compositor->runs[i].end_tile = tile_count * (i + 1) / worker_count;
+        p_compositor->runs[i].glyph_count = 0;
+    }
+
+    FPF_PROFILE_END("fpf_begin_composite");
+    return 0;
+}
+
+// Renders tiles of a composite until none are left: first from the worker's own run, then by
+// stealing from the other workers' runs. Safe to call from up to worker_count threads at once
+// (each with its own worker_index); the surface is finished once every call has returned.
+// Returns: the number of tiles this call rendered.
+size_t fpf_composite_tiles(
+    fpf_compositor *const   p_compositor,   // [in/out] Compositor prepared by fpf_begin_composite().
+    const unsigned int      worker_index    // [in]     Index of the calling worker; 0 .. worker_count - 1.
+    )
+{
+    const unsigned int worker_count = p_compositor->worker_count;
+    size_t tile_count = 0;
+    size_t glyph_count = 0;
+    unsigned int i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_composite_tiles");
+    FPF_assert(worker_index < worker_count || 0 == worker_count);
+
+    for (i = 0; i < worker_count; ++i)
+    {
+        fpf_compositor_run *const p_run = &p_compositor->runs[(worker_index + i) % worker_count];
+
+        for (;;)
+        {
+            const size_t tile = FPF_atomic_fetch_add(&p_run->next_tile, 1, relaxed);
+            fpf_clip_rect clip;
+            unsigned int entry; // For loops.
+
+            if (tile >= p_run->end_tile)
+            {
+                break;
+            }
+
+            clip.left = (int)((tile % p_compositor->tiles_across) * FPF_COMPOSITOR_TILE_SIZE);
+            clip.top = (int)((tile / p_compositor->tiles_across) * FPF_COMPOSITOR_TILE_SIZE);
+            clip.right = clip.left + (int)FPF_COMPOSITOR_TILE_SIZE;
+            clip.bottom = clip.top + (int)FPF_COMPOSITOR_TILE_SIZE;
+
+            for (entry = p_compositor->bin_starts[tile]; entry < p_compositor->bin_starts[tile + 1]; ++entry)
+            {
+                const fpf_draw_command *const p_command = &p_compositor->p_commands[p_compositor->bin_commands[entry]];
+
+                // Workers run at once, so they count glyphs themselves rather than in FPF_STATS.
+                glyph_count += fpf_draw_text_alpha8_clipped_uncounted(
+                    p_compositor->p_glyph_bits, p_compositor->p_surface, p_compositor->width, p_compositor->height,
+                    p_compositor->line_pitch, p_command->x, p_command->y, p_command->text, p_command->length,
+                    p_command->alpha, &clip, NULL);
+            }
+
+            ++tile_count;
+        }
+    }
+
+    if (worker_index < worker_count)
+    {
+        p_compositor->runs[worker_index].glyph_count = glyph_count;
+    }
+
+    FPF_PROFILE_END("fpf_composite_tiles");
+    return tile_count;
+}
+
+// Finishes a composite: call it on one thread once every fpf_composite_tiles() call has
+// returned. Adds the glyphs the workers drew to the FPF_STATS counters.
+// Returns: the number of glyphs drawn (a glyph cut by tile edges counts once per tile).
+size_t fpf_end_composite(
+    fpf_compositor *const p_compositor  // [in/out] Compositor whose workers have all returned.
+    )
+{
+    size_t glyph_count = 0;
+    unsigned int i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_end_composite");
+    FPF_assert(NULL != p_compositor);
+
+    for (i = 0; i < p_compositor->worker_count; ++i)
+    {
+        glyph_count += p_compositor->runs[i].glyph_count;
+    }
+
+    FPF_STAT_ADD(glyphs_emitted, glyph_count);
+    FPF_PROFILE_END("fpf_end_composite");
+    return glyph_count;
+}
+
+#endif // FPF_IMPLEMENTATION
+
+#endif // FPF_COMPOSITOR_H
@@ -0,0 +1,553 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: performance HUD
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+//
+//
+
+//
+// A ready-made performance overlay drawn with the five-pixel-font: the last frame time, min/avg/p99
+// over recent frames, a bar graph of frame times (drawn with the block cursor glyph as a solid
+// pixel), a panel of named counters and the HUD's own cost. It comes out as a single vertex batch
+// or a single software blit per frame.
+//
+//  1) Initialize the HUD once and register counters:
+//          static fpf_perf_hud hud;
+//          fpf_init_perf_hud(&hud);
+//          fpf_hud_counter *p_draw_calls = fpf_register_hud_counter(&hud, "draws");
+//
+//  2) Count things from any thread; counts are per frame:
+//          fpf_hud_count(p_draw_calls, 1);
+//
+//  3) At the end of each frame, record the frame time and draw the panel:
+//          fpf_end_hud_frame(&hud, frame_seconds);
+//          vertex_count = fpf_layout_perf_hud(&hud, 4.0f, 4.0f, 0xff00ff00u, FPF_VECTOR_Y_AXIS,
+//                                             vertices, FPF_HUD_MAX_VERTICES);
+//
+//  Notes: Counters may be bumped from any thread. Everything else belongs to one thread. Compiles
+//         as C11 or C++11 (see fpf_atomic.h).
+//
+
+#ifndef FPF_PERF_HUD_H
+#define FPF_PERF_HUD_H
+
+#include <stddef.h> // For size_t.
+#include "five_pixel_font.h"
+#include "fpf_atomic.h"
+
+// #define your own FPF_HUD_FRAME_COUNT to change how many frames the graph and statistics cover.
+#ifndef FPF_HUD_FRAME_COUNT
+#define FPF_HUD_FRAME_COUNT 120u
+#endif
+
+// #define your own FPF_HUD_MAX_COUNTERS to change how many counters can be registered.
+#ifndef FPF_HUD_MAX_COUNTERS
+#define FPF_HUD_MAX_COUNTERS 8u
+#endif
+
+// #define your own FPF_HUD_GRAPH_HEIGHT to change the height of the frame time graph (in pixels).
+#ifndef FPF_HUD_GRAPH_HEIGHT
+#define FPF_HUD_GRAPH_HEIGHT 24u
+#endif
+
+// Longest line of text in the panel (counter names are cut to fit).
+#define FPF_HUD_LINE_CHARS 32u
+
+// Lines of text in the panel: two above the graph, then one per counter and the HUD's own cost.
+#define FPF_HUD_MAX_LINES (3u + FPF_HUD_MAX_COUNTERS)
+
+// A vertex buffer this big always holds the whole panel.
+#define FPF_HUD_MAX_VERTICES ((FPF_HUD_MAX_LINES * FPF_HUD_LINE_CHARS + FPF_HUD_FRAME_COUNT) * FPF_VERTICES_PER_GLYPH)
+
+// A named counter shown in the panel.
+typedef struct
+{
+    const char          *name;      // Label in the panel; the string must outlive the HUD.
+    FPF_ATOMIC(size_t)  count;      // Counted so far this frame.
+    size_t              last_count; // Count for the last finished frame (what the panel shows).
+} fpf_hud_counter;
+
+typedef struct
+{
+    float           frame_ms[FPF_HUD_FRAME_COUNT];  // Ring buffer of frame times in milliseconds.
+    unsigned int    frame_count;                    // Number of frame times recorded (up to FPF_HUD_FRAME_COUNT).
+    unsigned int    next_frame;                     // Ring buffer index of the next frame time.
+    float           min_ms;                         // Statistics of the recorded frame times.
+    float           avg_ms;
+    float           p99_ms;
+    float           graph_ms;                       // Frame time drawn as a full-height bar (default 33.3 ms).
+    double          hud_seconds;                    // Time spent in the HUD so far this frame.
+    float           last_hud_ms;                    // Time spent in the HUD during the last finished frame.
+    unsigned int    counter_count;
+    fpf_hud_counter counters[FPF_HUD_MAX_COUNTERS];
+} fpf_perf_hud;
+
+// Declarations.
+void fpf_init_perf_hud(fpf_perf_hud *const p_hud);
+fpf_hud_counter *fpf_register_hud_counter(fpf_perf_hud *const p_hud, const char *const name);
+void fpf_hud_count(fpf_hud_counter *const p_counter, const size_t amount);
+void fpf_end_hud_frame(fpf_perf_hud *const p_hud, const double frame_seconds);
+size_t fpf_layout_perf_hud(fpf_perf_hud *const p_hud, const float x, const float y, const unsigned int color,
+                           const fpf_y_axis_direction y_axis_direction, fpf_vertex *const p_vertices,
+                           const size_t max_vertices);
+void fpf_draw_perf_hud_alpha8(fpf_perf_hud *const p_hud, const unsigned char *const p_glyph_bits,
+                              unsigned char *const p_surface, const unsigned int width, const unsigned int height,
+                              const size_t line_pitch, const int x, const int y, const unsigned char alpha);
+
+#ifdef FPF_IMPLEMENTATION
+
+// #define your own FPF_HUD_NOW_SECONDS() to time the HUD with your own clock.
+// The default is a monotonic clock: QueryPerformanceCounter() on Windows, clock_gettime(CLOCK_MONOTONIC)
+// where POSIX exposes it. A strict C/C++ build that hides POSIX (no _POSIX_C_SOURCE >= 199309L) falls
+// back to clock(), which counts processor time rather than elapsed time.
+#ifndef FPF_HUD_NOW_SECONDS
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h> // For QueryPerformanceCounter().
+#else
+#include <time.h> // For clock_gettime().
+#endif
+double fpf_hud_now_seconds(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#else
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+#define FPF_HUD_NOW_SECONDS() fpf_hud_now_seconds()
+#endif
+
+// Prepares a HUD with no frame times and no counters.
+void fpf_init_perf_hud(
+    fpf_perf_hud *const p_hud   // [out] HUD to initialize.
+    )
+{
+    FPF_assert(NULL != p_hud);
+    FPF_memset(p_hud->frame_ms, 0, sizeof(p_hud->frame_ms));
+    p_hud->frame_count = 0;
+    p_hud->next_frame = 0;
+    p_hud->min_ms = 0.0f;
+    p_hud->avg_ms = 0.0f;
+    p_hud->p99_ms = 0.0f;
+    p_hud->graph_ms = 1000.0f / 30.0f;
+    p_hud->hud_seconds = 0.0;
+    p_hud->last_hud_ms = 0.0f;
+    p_hud->counter_count = 0;
+}
+
+// Adds a named counter to the panel. Register counters before other threads start counting.
+// Returns: the counter, or NULL if FPF_HUD_MAX_COUNTERS are already registered.
+fpf_hud_counter *fpf_register_hud_counter(
+    fpf_perf_hud *const p_hud,  // [in/out] HUD to add the counter to.
+    const char *const   name    // [in]     Label; the string must outlive the HUD.
+    )
+{
+    fpf_hud_counter *p_counter;
+
+    FPF_assert(NULL != p_hud);
+    FPF_assert(NULL != name);
+
+    if (p_hud->counter_count >= FPF_HUD_MAX_COUNTERS)
+    {
+        return NULL;
+    }
+
+    p_counter = &p_hud->counters[p_hud->counter_count++];
+    p_counter->name = name;
+    FPF_atomic_store(&p_counter->count, 0, relaxed);
+    p_counter->last_count = 0;
+    return p_counter;
+}
+
+// Adds to a counter; safe to call from any thread, and costs a single atomic add.
+void fpf_hud_count(
+    fpf_hud_counter *const  p_counter,  // [in/out] Counter to add to.
+    const size_t            amount      // [in]     Amount to add.
+    )
+{
+    FPF_assert(NULL != p_counter);
+    FPF_atomic_fetch_add(&p_counter->count, amount, relaxed);
+}
+
+// Finds the k-th smallest of count values (reorders the values).
+float fpf_hud_select(
+    float *const        values, // [in/out] Values to search.
+    const unsigned int  count,  // [in]     Number of values.
+    const unsigned int  k       // [in]     Rank of the value to find (0 is the smallest).
+    )
+{
+    unsigned int low = 0;
+    unsigned int high = count - 1;
+
+    while (low < high)
+    {
+        const float pivot = values[(low + high) / 2];
+        unsigned int i = low;
+        unsigned int j = high;
+
+        while (i <= j)
+        {
+            while (values[i] < pivot) ++i;
+            while (values[j] > pivot) --j;
+            if (i <= j)
+            {
+                const float swap = values[i];
+                values[i] = values[j];
+                values[j] = swap;
+                ++i;
+                if (0 == j) break;
+                --j;
+            }
+        }
+
+        if (k <= j) high = j;
+        else if (k >= i) low = i;
+        else break;
+    }
+
+    return values[k];
+}
+
+// Records the last frame's time, updates the statistics and takes this frame's counts.
+void fpf_end_hud_frame(
+    fpf_perf_hud *const p_hud,          // [in/out] HUD to update.
+    const double        frame_seconds   // [in]     Time the frame took.
+    )
+{
+    const double start = FPF_HUD_NOW_SECONDS();
+
+    float sorted_ms[FPF_HUD_FRAME_COUNT];
+    float total_ms = 0.0f;
+    unsigned int i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_end_hud_frame");
+    FPF_assert(NULL != p_hud);
+
+    p_hud->frame_ms[p_hud->next_frame] = (float)(frame_seconds * 1000.0);
+    p_hud->next_frame = (p_hud->next_frame + 1) % FPF_HUD_FRAME_COUNT;
+    if (p_hud->frame_count < FPF_HUD_FRAME_COUNT)
+    {
+        ++p_hud->frame_count;
+    }
+
+    // The ring buffer starts at index 0 until it's full, so the first frame_count entries are valid.
+    p_hud->min_ms = p_hud->frame_ms[0];
+    for (i = 0; i < p_hud->frame_count; ++i)
+    {
+        sorted_ms[i] = p_hud->frame_ms[i];
+        total_ms += p_hud->frame_ms[i];
+        if (p_hud->frame_ms[i] < p_hud->min_ms)
+        {
+            p_hud->min_ms = p_hud->frame_ms[i];
+        }
+    }
+
+    p_hud->avg_ms = total_ms / p_hud->frame_count;
+    p_hud->p99_ms = fpf_hud_select(sorted_ms, p_hud->frame_count, (p_hud->frame_count * 99 + 99) / 100 - 1);
+
+    for (i = 0; i < p_hud->counter_count; ++i)
+    {
+        p_hud->counters[i].last_count = FPF_atomic_exchange(&p_hud->counters[i].count, 0, relaxed);
+    }
+
+    // Report what the HUD cost this frame (including this function).
+    p_hud->last_hud_ms = (float)((p_hud->hud_seconds + FPF_HUD_NOW_SECONDS() - start) * 1000.0);
+    p_hud->hud_seconds = 0.0;
+    FPF_PROFILE_END("fpf_end_hud_frame");
+}
+
+// Appends text to a panel line.
+void fpf_hud_append_text(
+    char *const         line,       // [in/out] Line of FPF_HUD_LINE_CHARS characters.
+    unsigned int *const p_length,   // [in/out] Length of the line.
+    const char         *text        // [in]     Null-terminated text to append.
+    )
+{
+    while ('\0' != *text && *p_length < FPF_HUD_LINE_CHARS)
+    {
+        line[(*p_length)++] = *text++;
+    }
+}
+
+// Appends a non-negative number with a fixed number of decimal places to a panel line.
+void fpf_hud_append_number(
+    char *const         line,       // [in/out] Line of FPF_HUD_LINE_CHARS characters.
+    unsigned int *const p_length,   // [in/out] Length of the line.
+    const double        value,      // [in]     Number to append.
+    const unsigned int  decimals    // [in]     Number of decimal places.
+    )
+{
+    char digits[24];
+    unsigned int digit_count = 0;
+    double scale = 1.0;
+    unsigned int i; // For loops.
+    size_t fixed;
+
+    for (i = 0; i < decimals; ++i)
+    {
+        scale *= 10.0;
+    }
+
+    fixed = (value > 0.0) ? (size_t)(value * scale + 0.5) : 0;
+
+    // Write the digits backwards, then copy them out in order.
+    do
+    {
+        if (0 != decimals && digit_count == decimals)
+        {
+            digits[digit_count++] = '.';
+        }
+        digits[digit_count++] = (char)('0' + fixed % 10);
+        fixed /= 10;
+    } while (0 != fixed || digit_count <= decimals);
+
+    while (0 != digit_count && *p_length < FPF_HUD_LINE_CHARS)
+    {
+        line[(*p_length)++] = digits[--digit_count];
+    }
+}
+
+// Formats the text of the panel: two lines above the graph, and the rest below it.
+// Returns: the number of lines.
+unsigned int fpf_format_perf_hud(
+    const fpf_perf_hud *const   p_hud,                                      // [in]  HUD to format.
+    char                        lines[FPF_HUD_MAX_LINES][FPF_HUD_LINE_CHARS], // [out] Text of each line.
+    unsigned int                lengths[FPF_HUD_MAX_LINES]                  // [out] Length of each line.
+    )
+{
+    const float last_ms = (0 == p_hud->frame_count) ? 0.0f :
+        p_hud->frame_ms[(p_hud->next_frame + FPF_HUD_FRAME_COUNT - 1) % FPF_HUD_FRAME_COUNT];
+    unsigned int line_count = 0;
+    unsigned int i; // For loops.
+
+    lengths[line_count] = 0;
+    fpf_hud_append_text(lines[line_count], &lengths[line_count], "frame ");
+    fpf_hud_append_number(lines[line_count], &lengths[line_count], last_ms, 2);
+    fpf_hud_append_text(lines[line_count], &lengths[line_count], " ms");
+    ++line_count;
+
+    lengths[line_count] = 0;
+    fpf_hud_append_text(lines[line_count], &lengths[line_count], "min ");
+    fpf_hud_append_number(lines[line_count], &lengths[line_count], p_hud->min_ms, 1);
+    fpf_hud_append_text(lines[line_count], &lengths[line_count], " avg ");
+    fpf_hud_append_number(lines[line_count], &lengths[line_count], p_hud->avg_ms, 1);
+    fpf_hud_append_text(lines[line_count], &lengths[line_count], " p99 ");
+    fpf_hud_append_number(lines[line_count], &lengths[line_count], p_hud->p99_ms, 1);
+    ++line_count;
+
+    for (i = 0; i < p_hud->counter_count; ++i)
+    {
+        lengths[line_count] = 0;
+        fpf_hud_append_text(lines[line_count], &lengths[line_count], p_hud->counters[i].name);
+        fpf_hud_append_text(lines[line_count], &lengths[line_count], " ");
+        fpf_hud_append_number(lines[line_count], &lengths[line_count], (double)p_hud->counters[i].last_count, 0);
+        ++line_count;
+    }
+
+    lengths[line_count] = 0;
+    fpf_hud_append_text(lines[line_count], &lengths[line_count], "hud ");
+    fpf_hud_append_number(lines[line_count], &lengths[line_count], p_hud->last_hud_ms, 3);
+    fpf_hud_append_text(lines[line_count], &lengths[line_count], " ms");
+    ++line_count;
+
+    return line_count;
+}
+
+// Gets the height (in pixels) of a frame's bar in the graph.
+unsigned int fpf_get_hud_bar_height(
+    const fpf_perf_hud *const   p_hud,  // [in] HUD to draw.
+    const unsigned int          bar     // [in] Bar index; 0 is the oldest recorded frame.
+    )
+{
+    const unsigned int first = (p_hud->frame_count < FPF_HUD_FRAME_COUNT) ? 0 : p_hud->next_frame;
+    const float ms = p_hud->frame_ms[(first + bar) % FPF_HUD_FRAME_COUNT];
+    const float height = ms / p_hud->graph_ms * FPF_HUD_GRAPH_HEIGHT;
+
+    if (height >= (float)FPF_HUD_GRAPH_HEIGHT)
+    {
+        return FPF_HUD_GRAPH_HEIGHT;
+    }
+
+    // Any frame gets at least a 1-pixel bar so the graph's extent is visible.
+    return (height < 1.0f) ? 1 : (unsigned int)height;
+}
+
+// Lays out the panel as one batch of quads (see fpf_layout_text()), with the top-left corner at
+// [x, y]. The graph is drawn with a solid patch of the block cursor glyph.
+// Returns: the number of vertices written.
+size_t fpf_layout_perf_hud(
+    fpf_perf_hud *const         p_hud,              // [in/out] HUD to draw.
+    const float                 x,                  // [in]     Left edge of the panel in pixels.
+    const float                 y,                  // [in]     Top edge of the panel in pixels.
+    const unsigned int          color,              // [in]     Color stored in every vertex.
+    const fpf_y_axis_direction  y_axis_direction,   // [in]     Direction of the texture's y-axis.
+    fpf_vertex *const           p_vertices,         // [out]    Vertex buffer to fill.
+    const size_t                max_vertices        // [in]     Capacity of the vertex buffer in vertices.
+    )
+{
+    const double start = FPF_HUD_NOW_SECONDS();
+
+    char lines[FPF_HUD_MAX_LINES][FPF_HUD_LINE_CHARS];
+    unsigned int lengths[FPF_HUD_MAX_LINES];
+    unsigned int line_count;
+    size_t vertex_count = 0;
+    float pen_y = y;
+    unsigned int solid_x;
+    unsigned int solid_y;
+    float solid_left;
+    float solid_top;
+    float solid_right;
+    float solid_bottom;
+    unsigned int i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_layout_perf_hud");
+    FPF_assert(NULL != p_hud);
+    FPF_assert(NULL != p_vertices || 0 == max_vertices);
+
+    line_count = fpf_format_perf_hud(p_hud, lines, lengths);
+
+    // Sample the middle of the block cursor so filtering never reaches a neighboring glyph.
+    fpf_get_cursor_glyph_position(FPF_BLOCK_CURSOR, &solid_x, &solid_y);
+    solid_left = (solid_x + 2.0f) / FPF_TEXTURE_WIDTH;
+    solid_right = (solid_x + 4.0f) / FPF_TEXTURE_WIDTH;
+    solid_top = (solid_y + 2.0f) / FPF_TEXTURE_HEIGHT;
+    solid_bottom = (solid_y + 4.0f) / FPF_TEXTURE_HEIGHT;
+    if (FPF_VECTOR_Y_AXIS == y_axis_direction)
+    {
+        solid_top = 1.0f - solid_top;
+        solid_bottom = 1.0f - solid_bottom;
+    }
+
+    for (i = 0; i < line_count; ++i)
+    {
+        vertex_count += fpf_layout_text(lines[i], lengths[i], x, pen_y, color, y_axis_direction,
+                                        &p_vertices[vertex_count], max_vertices - vertex_count);
+        pen_y += FPF_GLYPH_HEIGHT;
+
+        if (1 == i) // if (the graph goes here)
+        {
+            unsigned int bar; // For loops.
+
+            for (bar = 0; bar < p_hud->frame_count && vertex_count + FPF_VERTICES_PER_GLYPH <= max_vertices; ++bar)
+            {
+                const float bar_top = pen_y + (float)(FPF_HUD_GRAPH_HEIGHT - fpf_get_hud_bar_height(p_hud, bar));
+                fpf_emit_quad(
+                    &p_vertices[vertex_count],
+                    x + bar, bar_top, x + bar + 1.0f, pen_y + FPF_HUD_GRAPH_HEIGHT,
+                    solid_left, solid_top, solid_right, solid_bottom,
+                    color);
+                vertex_count += FPF_VERTICES_PER_GLYPH;
+            }
+
+            pen_y += FPF_HUD_GRAPH_HEIGHT + 1;
+        }
+    }
+
+    p_hud->hud_seconds += FPF_HUD_NOW_SECONDS() - start;
+    FPF_PROFILE_END("fpf_layout_perf_hud");
+    return vertex_count;
+}
+
+// Draws the panel into an 8-bit (alpha or grayscale) surface in software, with the top-left corner
+// at [x, y]; see fpf_draw_text_alpha8().
+void fpf_draw_perf_hud_alpha8(
+    fpf_perf_hud *const         p_hud,          // [in/out] HUD to draw.
+    const unsigned char *const  p_glyph_bits,   // [in]     Glyph bits from fpf_create_glyph_bits().
+    unsigned char *const        p_surface,      // [in/out] Surface to draw on; first byte is the top-left pixel.
+    const unsigned int          width,          // [in]     Width of the surface in pixels.
+    const unsigned int          height,         // [in]     Height of the surface in pixels.
+    const size_t                line_pitch,     // [in]     Line pitch of the surface in bytes.
+    const int                   x,              // [in]     Left edge of the panel in pixels.
+    const int                   y,              // [in]     Top edge of the panel in pixels.
+    const unsigned char         alpha           // [in]     Value written for text and graph pixels.
+    )
+{
+    const double start = FPF_HUD_NOW_SECONDS();
+
+    char lines[FPF_HUD_MAX_LINES][FPF_HUD_LINE_CHARS];
+    unsigned int lengths[FPF_HUD_MAX_LINES];
+    unsigned int line_count;
+    int pen_y = y;
+    unsigned int i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_draw_perf_hud_alpha8");
+    FPF_assert(NULL != p_hud);
+    FPF_assert(NULL != p_surface);
+
+    line_count = fpf_format_perf_hud(p_hud, lines, lengths);
+
+    for (i = 0; i < line_count; ++i)
+    {
+        fpf_draw_text_alpha8(p_glyph_bits, p_surface, width, height, line_pitch, x, pen_y, lines[i], lengths[i], alpha);
+        pen_y += FPF_GLYPH_HEIGHT;
+
+        if (1 == i) // if (the graph goes here)
+        {
+            unsigned int bar; // For loops.
+
+            for (bar = 0; bar < p_hud->frame_count; ++bar)
+            {
+                const int column = x + (int)bar;
+                int row; // For loops.
+
+                if (column < 0 || column >= (int)width)
+                {
+                    continue;
+                }
+
+                for (row = pen_y + (int)(FPF_HUD_GRAPH_HEIGHT - fpf_get_hud_bar_height(p_hud, bar));
+                     row < pen_y + (int)FPF_HUD_GRAPH_HEIGHT; ++row)
+                {
+                    if (row >= 0 && row < (int)height)
+                    {
+                        p_surface[row * line_pitch + column] = alpha;
+                    }
+                }
+            }
+
+            pen_y += FPF_HUD_GRAPH_HEIGHT + 1;
+        }
+    }
+
+    p_hud->hud_seconds += FPF_HUD_NOW_SECONDS() - start;
+    FPF_PROFILE_END("fpf_draw_perf_hud_alpha8");
+}
+
+#endif // FPF_IMPLEMENTATION
+
+#endif // FPF_PERF_HUD_H
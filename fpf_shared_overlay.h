@@ -0,0 +1,437 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: shared-memory text overlay
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+//
+//
+
+
+//
+// Lets several processes on one machine put text on the same output without pipes or copies
+// through a renderer. The overlay is a POSIX shared memory object holding one panel of text per
+// producer. A producer rewrites its panel whenever it likes; the consumer (the process that
+// owns the output) picks up changed panels once per frame and draws them. Each panel is guarded
+// by a sequence lock, so neither side ever waits: a producer just writes, and the consumer keeps
+// the last complete copy of any panel caught mid-write and tries again next frame.
+//
+//  1) In the consumer, create the overlay and a view (the consumer's private copy of the panels):
+//          fpf_shared_overlay *p_overlay = fpf_create_shared_overlay("/my_overlay");
+//          static fpf_overlay_view view;
+//          fpf_init_overlay_view(&view);
+//
+//  2) In each producer, open it, claim a panel, and write text whenever it changes:
+//          fpf_shared_overlay *p_overlay = fpf_open_shared_overlay("/my_overlay");
+//          int panel = fpf_claim_overlay_panel(p_overlay);
+//          fpf_write_overlay_panel(p_overlay, panel, 10, 10, 0xffffffffu, 0xff, "encoder: 59.9 fps");
+//
+//  3) Once per frame, in the consumer:
+//          fpf_update_overlay_view(p_overlay, &view);
+//          fpf_draw_overlay_view_alpha8(&view, glyph_bits, surface, width, height, pitch);
+//      or  vertex_count = fpf_layout_overlay_view(&view, FPF_VECTOR_Y_AXIS, vertices, max_vertices);
+//
+//  4) When done, fpf_close_shared_overlay() in every process, and fpf_remove_shared_overlay() once.
+//
+//  Notes: POSIX only (shm_open() and mmap()); build with POSIX features enabled (e.g. gnu11, or
+//         _POSIX_C_SOURCE 200112L), and link with -lrt on older C libraries. Every process has to
+//         be built with the same FPF_OVERLAY_* settings; opening an overlay created with other
+//         settings fails. Compiles as C11 (<stdatomic.h>) or C++11 (<atomic>).
+//
+
+#ifndef FPF_SHARED_OVERLAY_H
+#define FPF_SHARED_OVERLAY_H
+
+#include <stddef.h> // For size_t.
+#include "five_pixel_font.h"
+#include "fpf_atomic.h"
+
+// #define your own FPF_OVERLAY_MAX_PANELS to change the number of producers an overlay holds.
+#ifndef FPF_OVERLAY_MAX_PANELS
+#define FPF_OVERLAY_MAX_PANELS 16u
+#endif
+
+// #define your own FPF_OVERLAY_PANEL_CHARS to change the longest text a panel holds (longer text is cut).
+#ifndef FPF_OVERLAY_PANEL_CHARS
+#define FPF_OVERLAY_PANEL_CHARS 480u
+#endif
+
+// Identifies an initialized overlay built with the same settings.
+#define FPF_OVERLAY_MAGIC ((size_t)0x46504f56u ^ sizeof(fpf_shared_overlay))
+
+// A producer's text; newlines start a new line of text.
+typedef struct
+{
+    int             x;                              // Left edge of the text in pixels.
+    int             y;                              // Top edge of the text in pixels.
+    unsigned int    color;                          // Text color; copied into each vertex.
+    unsigned int    length;                         // Number of characters in the text.
+    unsigned char   alpha;                          // Value written for glyph pixels by software drawing.
+    char            text[FPF_OVERLAY_PANEL_CHARS];  // The text (not null-terminated).
+} fpf_overlay_panel_text;
+
+// A panel and its sequence number, which is odd while the producer is writing it.
+typedef struct
+{
+    FPF_ATOMIC(size_t)      sequence;
+    char                    padding[FPF_CACHE_LINE_SIZE - sizeof(size_t)];
+    fpf_overlay_panel_text  text;
+} fpf_overlay_panel;
+
+// The shared memory object; all fields live in shared memory.
+typedef struct
+{
+    FPF_ATOMIC(size_t)  magic;              // FPF_OVERLAY_MAGIC once the creator has initialized it.
+    FPF_ATOMIC(size_t)  claimed_count;      // Panels handed out by fpf_claim_overlay_panel().
+    char                padding[FPF_CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+    fpf_overlay_panel   panels[FPF_OVERLAY_MAX_PANELS];
+} fpf_shared_overlay;
+
+// The consumer's private copy of the panels; only the consumer touches it.
+typedef struct
+{
+    size_t                  sequences[FPF_OVERLAY_MAX_PANELS];  // Sequence number of each copied panel.
+    fpf_overlay_panel_text  panels[FPF_OVERLAY_MAX_PANELS];     // Last complete copy of each panel.
+    size_t                  torn_count;                         // Reads that caught a producer mid-write.
+} fpf_overlay_view;
+
+// Declarations.
+fpf_shared_overlay* fpf_create_shared_overlay(const char *const name);
+fpf_shared_overlay* fpf_open_shared_overlay(const char *const name);
+void fpf_close_shared_overlay(fpf_shared_overlay *const p_overlay);
+int fpf_remove_shared_overlay(const char *const name);
+int fpf_claim_overlay_panel(fpf_shared_overlay *const p_overlay);
+void fpf_write_overlay_panel(fpf_shared_overlay *const p_overlay, const int panel, const int x, const int y,
+                             const unsigned int color, const unsigned char alpha, const char *const text);
+void fpf_init_overlay_view(fpf_overlay_view *const p_view);
+size_t fpf_update_overlay_view(const fpf_shared_overlay *const p_overlay, fpf_overlay_view *const p_view);
+size_t fpf_draw_overlay_view_alpha8(const fpf_overlay_view *const p_view, const unsigned char *const p_glyph_bits,
+                                    unsigned char *const p_surface, const unsigned int width,
+                                    const unsigned int height, const size_t line_pitch);
+size_t fpf_layout_overlay_view(const fpf_overlay_view *const p_view, const fpf_y_axis_direction y_axis_direction,
+                               fpf_vertex *const p_vertices, const size_t max_vertices);
+
+#ifdef FPF_IMPLEMENTATION
+
+#include <fcntl.h>      // For O_CREAT, O_EXCL and O_RDWR.
+#include <sys/mman.h>   // For shm_open(), shm_unlink(), mmap() and munmap().
+#include <sys/stat.h>   // For fstat().
+#include <unistd.h>     // For ftruncate() and close().
+
+// Creates a new overlay with every panel empty, replacing any overlay with the same name (producers
+// still attached to the old one are cut off). Call it in the consumer before starting producers.
+// Returns: the overlay mapped into this process, or NULL on failure.
+fpf_shared_overlay* fpf_create_shared_overlay(
+    const char *const name  // [in] Name of the shared memory object; starts with a slash, e.g. "/my_overlay".
+    )
+{
+    fpf_shared_overlay *p_overlay;
+    void *p_mapping;
+    int fd;
+
+    FPF_PROFILE_BEGIN("fpf_create_shared_overlay");
+    FPF_assert(NULL != name);
+
+    shm_unlink(name);
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (-1 == fd)
+    {
+        FPF_PROFILE_END("fpf_create_shared_overlay");
+        return NULL;
+    }
+
+    // A newly sized shared memory object reads as zeros, so every panel starts empty.
+    if (0 != ftruncate(fd, (off_t)sizeof(fpf_shared_overlay)))
+    {
+        close(fd);
+        shm_unlink(name);
+        FPF_PROFILE_END("fpf_create_shared_overlay");
+        return NULL;
+    }
+
+    p_mapping = mmap(NULL, sizeof(fpf_shared_overlay), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == p_mapping)
+    {
+        shm_unlink(name);
+        FPF_PROFILE_END("fpf_create_shared_overlay");
+        return NULL;
+    }
+
+    p_overlay = (fpf_shared_overlay*)p_mapping;
+    FPF_atomic_store(&p_overlay->claimed_count, 0, relaxed);
+    FPF_atomic_store(&p_overlay->magic, FPF_OVERLAY_MAGIC, release);
+    FPF_PROFILE_END("fpf_create_shared_overlay");
+    return p_overlay;
+}
+
+// Maps an overlay that another process created.
+// Returns: the overlay mapped into this process, or NULL if it doesn't exist (yet), or was
+//          created with different FPF_OVERLAY_* settings.
+fpf_shared_overlay* fpf_open_shared_overlay(
+    const char *const name  // [in] Name the overlay was created with.
+    )
+{
+    fpf_shared_overlay *p_overlay;
+    struct stat status;
+    void *p_mapping;
+    int fd;
+
+    FPF_PROFILE_BEGIN("fpf_open_shared_overlay");
+    FPF_assert(NULL != name);
+
+    fd = shm_open(name, O_RDWR, 0);
+    if (-1 == fd)
+    {
+        FPF_PROFILE_END("fpf_open_shared_overlay");
+        return NULL;
+    }
+
+    if (0 != fstat(fd, &status) || (size_t)status.st_size < sizeof(fpf_shared_overlay))
+    {
+        close(fd);
+        FPF_PROFILE_END("fpf_open_shared_overlay");
+        return NULL;
+    }
+
+    p_mapping = mmap(NULL, sizeof(fpf_shared_overlay), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == p_mapping)
+    {
+        FPF_PROFILE_END("fpf_open_shared_overlay");
+        return NULL;
+    }
+
+    p_overlay = (fpf_shared_overlay*)p_mapping;
+    if (FPF_OVERLAY_MAGIC != FPF_atomic_load(&p_overlay->magic, acquire))
+    {
+        munmap(p_mapping, sizeof(fpf_shared_overlay));
+        FPF_PROFILE_END("fpf_open_shared_overlay");
+        return NULL;
+    }
+
+    FPF_PROFILE_END("fpf_open_shared_overlay");
+    return p_overlay;
+}
+
+// Unmaps an overlay from this process; the overlay itself lives on until it's removed.
+void fpf_close_shared_overlay(
+    fpf_shared_overlay *const p_overlay // [in] Overlay from fpf_create_shared_overlay() or fpf_open_shared_overlay().
+    )
+{
+    FPF_assert(NULL != p_overlay);
+    munmap((void*)p_overlay, sizeof(fpf_shared_overlay));
+}
+
+// Removes an overlay's name; its memory is freed once every process has closed it.
+// Returns: 0 on success, otherwise -1.
+int fpf_remove_shared_overlay(
+    const char *const name  // [in] Name the overlay was created with.
+    )
+{
+    FPF_assert(NULL != name);
+    return shm_unlink(name);
+}
+
+// Hands out a panel for a producer to write; safe to call from any number of processes at once.
+// Returns: the panel's index, or -1 if every panel has been claimed.
+int fpf_claim_overlay_panel(
+    fpf_shared_overlay *const p_overlay // [in/out] Overlay to claim a panel in.
+    )
+{
+    size_t panel;
+
+    FPF_assert(NULL != p_overlay);
+    panel = FPF_atomic_fetch_add(&p_overlay->claimed_count, 1, relaxed);
+    return (panel < FPF_OVERLAY_MAX_PANELS) ? (int)panel : -1;
+}
+
+// Replaces the text of a panel. Never blocks. Only one thread (in one process) may write a
+// given panel.
+void fpf_write_overlay_panel(
+    fpf_shared_overlay *const   p_overlay,  // [in/out] Overlay to write to.
+    const int                   panel,      // [in]     Panel from fpf_claim_overlay_panel().
+    const int                   x,          // [in]     Left edge of the text in pixels.
+    const int                   y,          // [in]     Top edge of the text in pixels.
+    const unsigned int          color,      // [in]     Text color; copied into each vertex.
+    const unsigned char         alpha,      // [in]     Value written for glyph pixels by software drawing.
+    const char *const           text        // [in]     Null-terminated text; cut at FPF_OVERLAY_PANEL_CHARS.
+    )
+{
+    fpf_overlay_panel *p_panel;
+    unsigned int length = 0;
+    size_t sequence;
+
+    FPF_PROFILE_BEGIN("fpf_write_overlay_panel");
+    FPF_assert(NULL != p_overlay);
+    FPF_assert(0 <= panel && panel < (int)FPF_OVERLAY_MAX_PANELS);
+    FPF_assert(NULL != text);
+
+    p_panel = &p_overlay->panels[panel];
+    sequence = FPF_atomic_load(&p_panel->sequence, relaxed);
+
+    // An odd sequence number tells the consumer the panel is being written.
+    FPF_atomic_store(&p_panel->sequence, sequence + 1, relaxed);
+    FPF_atomic_thread_fence(release);
+
+    while (length < FPF_OVERLAY_PANEL_CHARS && '\0' != text[length])
+    {
+        p_panel->text.text[length] = text[length];
+        ++length;
+    }
+
+    p_panel->text.x = x;
+    p_panel->text.y = y;
+    p_panel->text.color = color;
+    p_panel->text.alpha = alpha;
+    p_panel->text.length = length;
+
+    FPF_atomic_store(&p_panel->sequence, sequence + 2, release);
+    FPF_PROFILE_END("fpf_write_overlay_panel");
+}
+
+// Prepares an empty view.
+void fpf_init_overlay_view(
+    fpf_overlay_view *const p_view  // [out] View to initialize.
+    )
+{
+    FPF_assert(NULL != p_view);
+    FPF_memset(p_view, 0, sizeof(*p_view));
+}
+
+// Copies every panel that changed since the last update into the view. Never blocks: a panel
+// caught mid-write keeps its previous copy and is picked up by a later update.
+// Returns: the number of panels that changed.
+size_t fpf_update_overlay_view(
+    const fpf_shared_overlay *const p_overlay,  // [in]     Overlay to read.
+    fpf_overlay_view *const         p_view      // [in/out] The consumer's copy of the panels.
+    )
+{
+    fpf_overlay_panel_text copy;
+    size_t changed_count = 0;
+    size_t i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_update_overlay_view");
+    FPF_assert(NULL != p_overlay);
+    FPF_assert(NULL != p_view);
+
+    for (i = 0; i < FPF_OVERLAY_MAX_PANELS; ++i)
+    {
+        const fpf_overlay_panel *const p_panel = &p_overlay->panels[i];
+        const size_t sequence = FPF_atomic_load(&p_panel->sequence, acquire);
+
+        if (sequence == p_view->sequences[i]) // if (unchanged)
+        {
+            continue;
+        }
+
+        if (sequence & 1) // if (being written)
+        {
+            ++p_view->torn_count;
+            continue;
+        }
+
+        // Copy the panel, then make sure it wasn't rewritten while it was being copied.
+        FPF_memcpy(&copy, &p_panel->text, sizeof(copy));
+        FPF_atomic_thread_fence(acquire);
+
+        if (sequence != FPF_atomic_load(&p_panel->sequence, relaxed))
+        {
+            ++p_view->torn_count;
+            continue;
+        }
+
+        copy.length = (copy.length < FPF_OVERLAY_PANEL_CHARS) ? copy.length : FPF_OVERLAY_PANEL_CHARS;
+        FPF_memcpy(&p_view->panels[i], &copy, sizeof(copy));
+        p_view->sequences[i] = sequence;
+        ++changed_count;
+    }
+
+    FPF_PROFILE_END("fpf_update_overlay_view");
+    return changed_count;
+}
+
+// Draws every panel of a view into an 8-bit surface (see fpf_draw_text_alpha8()).
+// Returns: the number of glyphs drawn.
+size_t fpf_draw_overlay_view_alpha8(
+    const fpf_overlay_view *const   p_view,         // [in]     View to draw.
+    const unsigned char *const      p_glyph_bits,   // [in]     Glyph bits from fpf_create_glyph_bits().
+    unsigned char *const            p_surface,      // [in/out] Surface to draw on; first byte is the top-left pixel.
+    const unsigned int              width,          // [in]     Width of the surface in pixels.
+    const unsigned int              height,         // [in]     Height of the surface in pixels.
+    const size_t                    line_pitch      // [in]     Line pitch of the surface in bytes.
+    )
+{
+    size_t glyph_count = 0;
+    size_t i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_draw_overlay_view_alpha8");
+    FPF_assert(NULL != p_view);
+
+    for (i = 0; i < FPF_OVERLAY_MAX_PANELS; ++i)
+    {
+        const fpf_overlay_panel_text *const p_panel = &p_view->panels[i];
+
+        glyph_count += fpf_draw_text_alpha8(p_glyph_bits, p_surface, width, height, line_pitch, p_panel->x, p_panel->y,
+                                            p_panel->text, p_panel->length, p_panel->alpha);
+    }
+
+    FPF_PROFILE_END("fpf_draw_overlay_view_alpha8");
+    return glyph_count;
+}
+
+// Lays out every panel of a view into one batch of glyph quads (see fpf_layout_text()). Text
+// that doesn't fit in the vertex buffer is cut off.
+// Returns: the number of vertices written.
+size_t fpf_layout_overlay_view(
+    const fpf_overlay_view *const   p_view,             // [in]  View to lay out.
+    const fpf_y_axis_direction      y_axis_direction,   // [in]  Direction of the texture's y-axis.
+    fpf_vertex *const               p_vertices,         // [out] Vertex buffer to fill.
+    const size_t                    max_vertices        // [in]  Capacity of the vertex buffer in vertices.
+    )
+{
+    size_t vertex_count = 0;
+    size_t i; // For loops.
+
+    FPF_PROFILE_BEGIN("fpf_layout_overlay_view");
+    FPF_assert(NULL != p_view);
+    FPF_assert(NULL != p_vertices);
+
+    for (i = 0; i < FPF_OVERLAY_MAX_PANELS; ++i)
+    {
+        const fpf_overlay_panel_text *const p_panel = &p_view->panels[i];
+
+        vertex_count += fpf_layout_text(p_panel->text, p_panel->length, (float)p_panel->x, (float)p_panel->y,
+                                        p_panel->color, y_axis_direction, &p_vertices[vertex_count],
+                                        max_vertices - vertex_count);
+    }
+
+    FPF_PROFILE_END("fpf_layout_overlay_view");
+    return vertex_count;
+}
+
+#endif // FPF_IMPLEMENTATION
+
+#endif // FPF_SHARED_OVERLAY_H
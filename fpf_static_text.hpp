@@ -0,0 +1,309 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: compile-time static text
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+//
+//
+
+
+//
+// An optional C++20 layer that renders fixed text (build IDs, unit names, menu captions) into a
+// packed bitmap at compile time. The font is decoded from FPF_COMPRESSED_FONT_BYTES by consteval
+// code, so the finished sprite is a constant in read-only data: at run time there's no layout, no
+// glyph lookup and no atlas to decode, just one copy to a surface or a texture. It only uses the
+// macros from five_pixel_font.h (it doesn't need FPF_IMPLEMENTATION), and matches
+// fpf_draw_text_alpha8() pixel-for-pixel.
+//
+//  1) Render a string literal as 8-bit alpha (0x00 or 0xff per pixel) or 1 bit per pixel:
+//          constexpr auto &build_label = fpf::static_text<"build 1234">;
+//          constexpr auto &unit_label = fpf::static_text<"rpm", fpf::sprite_format::bits1>;
+//
+//  2) Copy it to a surface (clipped to the surface):
+//          fpf::blit(build_label, surface, width, height, pitch, 10, 10);      // A8: copies whole rows.
+//          fpf::blit(unit_label, surface, width, height, pitch, 10, 20, 0xff); // 1bpp: sets glyph pixels to alpha.
+//
+//     or upload it as is: the rows are tightly packed (line_pitch bytes each), e.g.
+//          glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, build_label.width, build_label.height, 0, GL_RED,
+//                       GL_UNSIGNED_BYTE, build_label.pixels.data());  // With GL_UNPACK_ALIGNMENT 1.
+//
+//  Notes: Each character takes a FPF_GLYPH_WIDTH x FPF_GLYPH_HEIGHT cell, and a newline starts a
+//         new line, so a sprite is the longest line wide by the number of lines high. 1bpp rows
+//         hold the left-most pixel in the most significant bit and are padded to whole bytes.
+//
+
+#ifndef FPF_STATIC_TEXT_HPP
+#define FPF_STATIC_TEXT_HPP
+
+#include <array>
+#include <cstddef>      // For std::size_t.
+#include <cstring>      // For std::memcpy().
+#include "five_pixel_font.h"
+
+namespace fpf
+{
+
+// Pixel format of a static text sprite.
+enum class sprite_format
+{
+    bits1,  // 1 bit per pixel, left-most pixel in the most significant bit; rows padded to whole bytes.
+    alpha8  // 1 byte per pixel; 0xff for glyph pixels, otherwise 0x00.
+};
+
+// A string literal usable as a template argument.
+template <std::size_t N>
+struct fixed_string
+{
+    char text[N] = {};
+
+    consteval fixed_string(const char (&literal)[N]) noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            text[i] = literal[i];
+        }
+    }
+
+    static constexpr std::size_t length = N - 1;
+};
+
+// Rendered text, Width x Height pixels.
+template <std::size_t Width, std::size_t Height, sprite_format Format>
+struct static_sprite
+{
+    static constexpr std::size_t width = Width;
+    static constexpr std::size_t height = Height;
+    static constexpr sprite_format format = Format;
+    static constexpr std::size_t line_pitch = (sprite_format::bits1 == Format) ? (Width + 7) / 8 : Width;
+
+    std::array<unsigned char, line_pitch * Height> pixels;  // Rows of pixels, top row first.
+};
+
+namespace detail
+{
+
+// The size of some text in character cells.
+struct text_extent
+{
+    std::size_t columns;
+    std::size_t lines;
+};
+
+template <std::size_t N>
+consteval text_extent measure_text(const fixed_string<N> &text) noexcept
+{
+    text_extent extent{ 0, (0 == text.length) ? 0u : 1u };
+    std::size_t column = 0;
+
+    for (std::size_t i = 0; i < text.length; ++i)
+    {
+        if ('\n' == text.text[i])
+        {
+            column = 0;
+            ++extent.lines;
+            continue;
+        }
+
+        ++column;
+        extent.columns = (column > extent.columns) ? column : extent.columns;
+    }
+
+    return extent;
+}
+
+// Decompresses the whole texture atlas as a bitmap (one bit per texel), like fpf_decode_atlas_bits().
+consteval std::array<unsigned char, FPF_TEXTURE_HEIGHT * FPF_ROW_BITS_SIZE> decode_atlas_bits() noexcept
+{
+    constexpr unsigned char compressed_font[] = { FPF_COMPRESSED_FONT_BYTES };
+    std::array<unsigned char, FPF_TEXTURE_HEIGHT * FPF_ROW_BITS_SIZE> atlas_bits{};
+    std::size_t out = 0;
+
+    for (std::size_t i = 0; i < sizeof(compressed_font) && out < atlas_bits.size(); ++i)
+    {
+        if (0 == compressed_font[i]) // if (this byte indicates a run of zeros)
+        {
+            out += compressed_font[++i];
+            continue;
+        }
+
+        atlas_bits[out++] = compressed_font[i];
+    }
+
+    return atlas_bits;
+}
+
+} // namespace detail
+
+// Renders text at compile time; see fpf::static_text for a ready-made constant.
+template <fixed_string Text, sprite_format Format = sprite_format::alpha8>
+consteval auto make_static_text() noexcept
+{
+    constexpr detail::text_extent extent = detail::measure_text(Text);
+    constexpr unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
+    using sprite_type = static_sprite<extent.columns * FPF_GLYPH_WIDTH, extent.lines * FPF_GLYPH_HEIGHT, Format>;
+
+    const auto atlas_bits = detail::decode_atlas_bits();
+    sprite_type sprite{};
+    std::size_t column = 0;
+    std::size_t line = 0;
+
+    for (std::size_t i = 0; i < Text.length; ++i)
+    {
+        const char character = Text.text[i];
+
+        if ('\n' == character)
+        {
+            column = 0;
+            ++line;
+            continue;
+        }
+
+        if (' ' != character && '\t' != character)
+        {
+            // Same glyph and texel arithmetic as fpf_get_glyph_index() and fpf_create_glyph_bits().
+            const unsigned int glyph_index = (character < ' ' || character > '~') ? 127u - ' ' : (unsigned int)(character - ' ');
+            const unsigned int texel_x = (glyph_index % glyphs_per_row) * FPF_GLYPH_WIDTH;
+            const unsigned int texel_y = (glyph_index / glyphs_per_row) * FPF_GLYPH_HEIGHT;
+
+            for (unsigned int row = 0; row < FPF_GLYPH_HEIGHT; ++row)
+            {
+                for (unsigned int texel = 0; texel < FPF_GLYPH_WIDTH; ++texel)
+                {
+                    const unsigned int atlas_x = texel_x + texel;
+                    const std::size_t x = column * FPF_GLYPH_WIDTH + texel;
+                    const std::size_t y = line * FPF_GLYPH_HEIGHT + row;
+
+                    if (0 == (atlas_bits[(texel_y + row) * FPF_ROW_BITS_SIZE + atlas_x / 8] & (0x80u >> (atlas_x % 8))))
+                    {
+                        continue;
+                    }
+
+                    if constexpr (sprite_format::bits1 == Format)
+                    {
+                        sprite.pixels[y * sprite_type::line_pitch + x / 8] |= (unsigned char)(0x80u >> (x % 8));
+                    }
+                    else
+                    {
+                        sprite.pixels[y * sprite_type::line_pitch + x] = 0xff;
+                    }
+                }
+            }
+        }
+
+        ++column;
+    }
+
+    return sprite;
+}
+
+// The text rendered at compile time, as a constant (in read-only data once it's used).
+template <fixed_string Text, sprite_format Format = sprite_format::alpha8>
+inline constexpr auto static_text = make_static_text<Text, Format>();
+
+namespace detail
+{
+
+// The columns and rows of a sprite at [x, y] that land on a surface.
+struct blit_span
+{
+    long first_column, end_column, first_row, end_row;
+};
+
+constexpr blit_span clip_sprite(std::size_t sprite_width, std::size_t sprite_height, unsigned int width,
+                                unsigned int height, int x, int y) noexcept
+{
+    blit_span span{ (x < 0) ? -(long)x : 0, (long)width - x, (y < 0) ? -(long)y : 0, (long)height - y };
+
+    span.end_column = (span.end_column > (long)sprite_width) ? (long)sprite_width : span.end_column;
+    span.end_row = (span.end_row > (long)sprite_height) ? (long)sprite_height : span.end_row;
+    return span;
+}
+
+} // namespace detail
+
+// Copies an 8-bit sprite onto an 8-bit surface with one memcpy per row, background included
+// (so it replaces whatever was under it). Clipped to the surface.
+template <std::size_t Width, std::size_t Height>
+void blit(
+    const static_sprite<Width, Height, sprite_format::alpha8>  &sprite,         // [in]     Sprite to copy.
+    unsigned char                                              *p_surface,      // [in/out] Surface; first byte is the top-left pixel.
+    unsigned int                                                width,          // [in]     Width of the surface in pixels.
+    unsigned int                                                height,         // [in]     Height of the surface in pixels.
+    std::size_t                                                 line_pitch,     // [in]     Line pitch of the surface in bytes.
+    int                                                         x,              // [in]     Left edge of the sprite in pixels.
+    int                                                         y               // [in]     Top edge of the sprite in pixels.
+    ) noexcept
+{
+    const detail::blit_span span = detail::clip_sprite(Width, Height, width, height, x, y);
+
+    if (span.first_column >= span.end_column)
+    {
+        return;
+    }
+
+    for (long row = span.first_row; row < span.end_row; ++row)
+    {
+        std::memcpy(&p_surface[(std::size_t)(y + row) * line_pitch + (std::size_t)(x + span.first_column)],
+                    &sprite.pixels[(std::size_t)row * Width + (std::size_t)span.first_column],
+                    (std::size_t)(span.end_column - span.first_column));
+    }
+}
+
+// Draws a 1bpp sprite onto an 8-bit surface: glyph pixels are set to alpha and the rest is left
+// untouched, like fpf_draw_text_alpha8(). Clipped to the surface.
+template <std::size_t Width, std::size_t Height>
+void blit(
+    const static_sprite<Width, Height, sprite_format::bits1>   &sprite,         // [in]     Sprite to draw.
+    unsigned char                                              *p_surface,      // [in/out] Surface; first byte is the top-left pixel.
+    unsigned int                                                width,          // [in]     Width of the surface in pixels.
+    unsigned int                                                height,         // [in]     Height of the surface in pixels.
+    std::size_t                                                 line_pitch,     // [in]     Line pitch of the surface in bytes.
+    int                                                         x,              // [in]     Left edge of the sprite in pixels.
+    int                                                         y,              // [in]     Top edge of the sprite in pixels.
+    unsigned char                                               alpha = 0xff    // [in]     Value written for glyph pixels.
+    ) noexcept
+{
+    using sprite_type = static_sprite<Width, Height, sprite_format::bits1>;
+    const detail::blit_span span = detail::clip_sprite(Width, Height, width, height, x, y);
+
+    for (long row = span.first_row; row < span.end_row; ++row)
+    {
+        const unsigned char *const p_bits = &sprite.pixels[(std::size_t)row * sprite_type::line_pitch];
+        unsigned char *const p_dst = &p_surface[(std::size_t)(y + row) * line_pitch];
+
+        for (long column = span.first_column; column < span.end_column; ++column)
+        {
+            if (p_bits[column / 8] & (0x80u >> (column % 8)))
+            {
+                p_dst[x + column] = alpha;
+            }
+        }
+    }
+}
+
+} // namespace fpf
+
+#endif // FPF_STATIC_TEXT_HPP
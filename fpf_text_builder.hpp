@@ -0,0 +1,340 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: C++ text builder
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+//
+//
+
+//
+// An optional C++17 layer over the five-pixel-font that lays out text straight into your engine's
+// own vertex format. The vertex format is a compile-time policy, so each engine gets its own
+// specialized, fully inlined emitter: no per-glyph function pointers, no conversion pass and no
+// heap allocation. It only uses the macros and enums from five_pixel_font.h (it doesn't need
+// FPF_IMPLEMENTATION), and matches fpf_layout_text() vertex-for-vertex.
+//
+//  1) Describe your vertex format, either with one of the ready-made policies:
+//          struct float2 { float x, y; };
+//          using my_format = fpf::vertex_format<float2, float2, std::uint32_t, fpf::primitive::triangle_list>;
+//
+//     or with your own policy struct:
+//          struct my_format
+//          {
+//              using vertex_type = my_vertex;
+//              using color_type = std::uint32_t;
+//              static constexpr fpf::primitive topology = fpf::primitive::triangle_list;
+//              static constexpr vertex_type make_vertex(float x, float y, float u, float v, color_type color) noexcept;
+//          };
+//
+//  2) Lay out text into a std::span, a pointer and capacity, or any output iterator:
+//          fpf::text_builder<my_format> builder(4.0f, 4.0f, 0xff00ff00u, FPF_VECTOR_Y_AXIS);
+//          const std::size_t vertex_count = builder.append("frame 1234", vertices); // std::span<my_vertex>
+//
+//  Notes: Triangle lists take FPF_VERTICES_PER_GLYPH vertices per glyph. Triangle strips take 6
+//         (the quad's 4 plus one repeat at each end), so glyphs join into one strip with
+//         degenerate triangles. Instances take one vertex (your make_instance()) per glyph.
+//
+
+#ifndef FPF_TEXT_BUILDER_HPP
+#define FPF_TEXT_BUILDER_HPP
+
+#include <cstddef>      // For std::size_t.
+#include <string_view>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#include "five_pixel_font.h"
+
+namespace fpf
+{
+
+// How a policy's vertices are assembled into primitives.
+enum class primitive
+{
+    triangle_list,  // FPF_VERTICES_PER_GLYPH vertices per glyph, as fpf_layout_text().
+    triangle_strip, // 6 vertices per glyph, one long strip joined with degenerate triangles.
+    instance        // 1 vertex per glyph, made by the policy's make_instance().
+};
+
+// A glyph's screen rectangle (in pixels) and texture rectangle, handed to make_instance().
+template <class Color>
+struct glyph_quad
+{
+    float x0, y0, x1, y1;   // Left, top, right and bottom edges in pixels.
+    float u0, v0, u1, v1;   // Texture coordinates of the left, top, right and bottom edges.
+    Color color;
+};
+
+// A ready-made policy for the usual {position, texture coordinate, color} vertex. Position and
+// TexCoord must be constructible from two floats (e.g. a struct of two floats, or a math
+// library's vec2).
+template <class Position, class TexCoord, class Color, primitive Topology>
+struct vertex_format
+{
+    static_assert(primitive::instance != Topology, "use fpf::instance_format for instanced glyphs");
+
+    struct vertex_type
+    {
+        Position    position;
+        TexCoord    tex_coord;
+        Color       color;
+    };
+
+    using color_type = Color;
+    static constexpr primitive topology = Topology;
+
+    static constexpr vertex_type make_vertex(float x, float y, float u, float v, Color color) noexcept
+    {
+        return vertex_type{ Position{ x, y }, TexCoord{ u, v }, color };
+    }
+};
+
+// A ready-made policy with one instance per glyph (the vertex shader expands each into a quad).
+template <class Position, class TexCoord, class Color>
+struct instance_format
+{
+    struct vertex_type
+    {
+        Position    top_left;
+        Position    bottom_right;
+        TexCoord    tex_top_left;
+        TexCoord    tex_bottom_right;
+        Color       color;
+    };
+
+    using color_type = Color;
+    static constexpr primitive topology = primitive::instance;
+
+    static constexpr vertex_type make_instance(const glyph_quad<Color> &quad) noexcept
+    {
+        return vertex_type{ Position{ quad.x0, quad.y0 }, Position{ quad.x1, quad.y1 },
+                            TexCoord{ quad.u0, quad.v0 }, TexCoord{ quad.u1, quad.v1 }, quad.color };
+    }
+};
+
+// The library's own fpf_vertex as a triangle list (the same output as fpf_layout_text()).
+struct fpf_vertex_format
+{
+    using vertex_type = fpf_vertex;
+    using color_type = unsigned int;
+    static constexpr primitive topology = primitive::triangle_list;
+
+    static constexpr vertex_type make_vertex(float x, float y, float u, float v, unsigned int color) noexcept
+    {
+        return vertex_type{ x, y, u, v, color };
+    }
+};
+
+// Lays out text with a vertex-format policy. The builder only holds the pen position, so it's
+// cheap to make one per string, or to keep one and append to it (a newline returns the pen to the
+// left edge given to the constructor or move_to()).
+template <class VertexPolicy>
+class text_builder
+{
+public:
+    using policy_type = VertexPolicy;
+    using vertex_type = typename VertexPolicy::vertex_type;
+    using color_type = typename VertexPolicy::color_type;
+
+    static constexpr std::size_t vertices_per_glyph =
+        (primitive::triangle_list == VertexPolicy::topology) ? FPF_VERTICES_PER_GLYPH :
+        (primitive::triangle_strip == VertexPolicy::topology) ? 6 : 1;
+
+    constexpr text_builder(
+        float                   x,                                      // [in] Left edge of the text in pixels.
+        float                   y,                                      // [in] Top edge of the text in pixels.
+        color_type              color,                                  // [in] Color stored in every vertex.
+        fpf_y_axis_direction    y_axis_direction = FPF_RASTER_Y_AXIS    // [in] Direction of the texture's y-axis.
+        ) noexcept
+        : m_left(x), m_pen_x(x), m_pen_y(y), m_color(color), m_y_axis_direction(y_axis_direction)
+    {
+    }
+
+    // Moves the pen; new lines will also start at x.
+    constexpr void move_to(float x, float y) noexcept
+    {
+        m_left = x;
+        m_pen_x = x;
+        m_pen_y = y;
+    }
+
+    constexpr void set_color(color_type color) noexcept { m_color = color; }
+    constexpr float pen_x() const noexcept { return m_pen_x; }
+    constexpr float pen_y() const noexcept { return m_pen_y; }
+
+    // The most vertices that text could need (every character a visible glyph).
+    static constexpr std::size_t max_vertex_count(std::string_view text) noexcept
+    {
+        return text.size() * vertices_per_glyph;
+    }
+
+    // Lays out all of the text through an output iterator (e.g. a pointer into a buffer of at
+    // least max_vertex_count() vertices).
+    // Returns: the iterator past the last vertex written.
+    template <class OutputIt>
+    constexpr OutputIt append(std::string_view text, OutputIt out)
+    {
+        for (const char character : text)
+        {
+            if (advance(character))
+            {
+                out = emit_glyph(character, out);
+            }
+        }
+
+        return out;
+    }
+
+    // Lays out as much of the text as fits in a buffer, without splitting a glyph. The pen stops at
+    // the first glyph that didn't fit.
+    // Returns: the number of vertices written.
+    constexpr std::size_t append(std::string_view text, vertex_type *p_vertices, std::size_t max_vertices)
+    {
+        std::size_t vertex_count = 0;
+
+        for (const char character : text)
+        {
+            if (!is_space(character) && vertex_count + vertices_per_glyph > max_vertices) // if (out of room)
+            {
+                break;
+            }
+
+            if (advance(character))
+            {
+                emit_glyph(character, p_vertices + vertex_count);
+                vertex_count += vertices_per_glyph;
+            }
+        }
+
+        return vertex_count;
+    }
+
+#if __cplusplus >= 202002L
+    // Lays out as much of the text as fits in a span; see above.
+    // Returns: the number of vertices written.
+    constexpr std::size_t append(std::string_view text, std::span<vertex_type> vertices)
+    {
+        return append(text, vertices.data(), vertices.size());
+    }
+#endif
+
+private:
+    static constexpr bool is_space(char character) noexcept
+    {
+        return ' ' == character || '\t' == character || '\n' == character;
+    }
+
+    // Handles newlines and spaces.
+    // Returns: true if the character needs a glyph drawn at the pen.
+    constexpr bool advance(char character) noexcept
+    {
+        if ('\n' == character)
+        {
+            m_pen_x = m_left;
+            m_pen_y += FPF_GLYPH_HEIGHT;
+            return false;
+        }
+
+        if (' ' == character || '\t' == character)
+        {
+            m_pen_x += FPF_GLYPH_WIDTH;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Writes a glyph at the pen and advances the pen.
+    template <class OutputIt>
+    constexpr OutputIt emit_glyph(char character, OutputIt out)
+    {
+        // Same arithmetic as fpf_get_glyph_position() and fpf_get_glyph_dx_texture_coordinates(),
+        // so the results match the C functions exactly.
+        const unsigned int glyph_index = (character < ' ' || character > '~') ? 127u - ' ' : (unsigned int)(character - ' ');
+        const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
+        const unsigned int texel_x = (glyph_index % glyphs_per_row) * FPF_GLYPH_WIDTH;
+        const unsigned int texel_y = (glyph_index / glyphs_per_row) * FPF_GLYPH_HEIGHT;
+        glyph_quad<color_type> quad{
+            m_pen_x, m_pen_y, m_pen_x + FPF_GLYPH_WIDTH, m_pen_y + FPF_GLYPH_HEIGHT,
+            (float)texel_x / FPF_TEXTURE_WIDTH, (float)texel_y / FPF_TEXTURE_HEIGHT,
+            (float)(texel_x + FPF_GLYPH_WIDTH) / FPF_TEXTURE_WIDTH, (float)(texel_y + FPF_GLYPH_HEIGHT) / FPF_TEXTURE_HEIGHT,
+            m_color };
+
+        if (FPF_VECTOR_Y_AXIS == m_y_axis_direction)
+        {
+            quad.v0 = 1.0f - quad.v0;
+            quad.v1 = 1.0f - quad.v1;
+        }
+
+        m_pen_x += FPF_GLYPH_WIDTH;
+
+        if constexpr (primitive::instance == VertexPolicy::topology)
+        {
+            *out++ = VertexPolicy::make_instance(quad);
+        }
+        else
+        {
+            const vertex_type top_left = VertexPolicy::make_vertex(quad.x0, quad.y0, quad.u0, quad.v0, quad.color);
+            const vertex_type top_right = VertexPolicy::make_vertex(quad.x1, quad.y0, quad.u1, quad.v0, quad.color);
+            const vertex_type bottom_left = VertexPolicy::make_vertex(quad.x0, quad.y1, quad.u0, quad.v1, quad.color);
+            const vertex_type bottom_right = VertexPolicy::make_vertex(quad.x1, quad.y1, quad.u1, quad.v1, quad.color);
+
+            if constexpr (primitive::triangle_list == VertexPolicy::topology)
+            {
+                // Same order as fpf_emit_quad().
+                *out++ = top_left;
+                *out++ = top_right;
+                *out++ = bottom_left;
+                *out++ = bottom_left;
+                *out++ = top_right;
+                *out++ = bottom_right;
+            }
+            else
+            {
+                // The repeated first and last vertices join glyphs with degenerate triangles. Six
+                // vertices per glyph keeps the winding the same for every glyph.
+                *out++ = top_left;
+                *out++ = top_left;
+                *out++ = top_right;
+                *out++ = bottom_left;
+                *out++ = bottom_right;
+                *out++ = bottom_right;
+            }
+        }
+
+        return out;
+    }
+
+    float                   m_left;
+    float                   m_pen_x;
+    float                   m_pen_y;
+    color_type              m_color;
+    fpf_y_axis_direction    m_y_axis_direction;
+};
+
+} // namespace fpf
+
+#endif // FPF_TEXT_BUILDER_HPP
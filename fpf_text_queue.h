@@ -0,0 +1,262 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: lock-free debug text queue
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+//
+//
+
+//
+// A bounded, lock-free, multi-producer / single-consumer queue of debug text. Any thread can push
+// a short line of text (it's copied into a fixed-size record; nothing is allocated), and the render
+// thread drains everything pending into one batch of glyph quads. When the queue is full a push
+// drops the text and counts it rather than blocking.
+//
+//  1) Initialize a queue once (it's big; make it static or allocate it):
+//          static fpf_text_queue debug_text;
+//          fpf_init_text_queue(&debug_text);
+//
+//  2) From any thread:
+//          fpf_push_text(&debug_text, 10.0f, 10.0f, 0xff00ff00u, "job 42: 1.3 ms");
+//
+//  3) Once per frame, on the render thread:
+//          vertex_count = fpf_drain_text_queue(&debug_text, FPF_VECTOR_Y_AXIS, vertices, max_vertices);
+//
+//  Notes: Compiles as C11 (<stdatomic.h>) or C++11 (<atomic>).
+//
+
+#ifndef FPF_TEXT_QUEUE_H
+#define FPF_TEXT_QUEUE_H
+
+#include <stddef.h> // For size_t.
+#include "five_pixel_font.h"
+#include "fpf_atomic.h"
+
+// #define your own FPF_TEXT_QUEUE_CAPACITY (a power of two) to change the number of records.
+#ifndef FPF_TEXT_QUEUE_CAPACITY
+#define FPF_TEXT_QUEUE_CAPACITY 256u
+#endif
+
+// #define your own FPF_TEXT_RECORD_CHARS to change the longest text a record holds (longer text is cut).
+#ifndef FPF_TEXT_RECORD_CHARS
+#define FPF_TEXT_RECORD_CHARS 52u
+#endif
+
+// A line of text waiting to be drawn.
+typedef struct
+{
+    float           x;                              // Left edge of the text in pixels.
+    float           y;                              // Top edge of the text in pixels.
+    unsigned int    color;                          // Text color; copied into each vertex.
+    unsigned int    length;                         // Number of characters in the text.
+    char            text[FPF_TEXT_RECORD_CHARS];    // The text (not null-terminated).
+} fpf_text_record;
+
+// A record and its sequence number, which says whether it's free or ready to be drawn.
+typedef struct
+{
+    FPF_ATOMIC(size_t)  sequence;
+    fpf_text_record     record;
+} fpf_text_queue_slot;
+
+typedef struct
+{
+    fpf_text_queue_slot slots[FPF_TEXT_QUEUE_CAPACITY];
+    FPF_ATOMIC(size_t)  push_position;      // Next slot for producers to claim.
+    char                padding0[FPF_CACHE_LINE_SIZE - sizeof(size_t)];
+    size_t              drain_position;     // Next slot for the consumer to draw; only the consumer touches it.
+    char                padding1[FPF_CACHE_LINE_SIZE - sizeof(size_t)];
+    FPF_ATOMIC(size_t)  dropped_count;      // Records dropped because the queue was full.
+} fpf_text_queue;
+
+// Declarations.
+void fpf_init_text_queue(fpf_text_queue *const p_queue);
+int fpf_push_text(fpf_text_queue *const p_queue, const float x, const float y, const unsigned int color,
+                  const char *const text);
+size_t fpf_drain_text_queue(fpf_text_queue *const p_queue, const fpf_y_axis_direction y_axis_direction,
+                            fpf_vertex *const p_vertices, const size_t max_vertices);
+size_t fpf_take_text_queue_dropped_count(fpf_text_queue *const p_queue);
+
+#ifdef FPF_IMPLEMENTATION
+
+// Prepares an empty queue. Call it before any thread pushes text.
+void fpf_init_text_queue(
+    fpf_text_queue *const p_queue   // [out] Queue to initialize.
+    )
+{
+    size_t i; // For loops.
+
+    FPF_assert(NULL != p_queue);
+    FPF_assert(0 == (FPF_TEXT_QUEUE_CAPACITY & (FPF_TEXT_QUEUE_CAPACITY - 1)));
+
+    for (i = 0; i < FPF_TEXT_QUEUE_CAPACITY; ++i)
+    {
+        FPF_atomic_store(&p_queue->slots[i].sequence, i, relaxed);
+    }
+
+    FPF_atomic_store(&p_queue->push_position, 0, relaxed);
+    p_queue->drain_position = 0;
+    FPF_atomic_store(&p_queue->dropped_count, 0, release);
+}
+
+// Copies a line of text into the queue; safe to call from any number of threads at once. Never
+// blocks: if the queue is full, the text is dropped and counted.
+// Returns: 1 if the text was queued, otherwise 0 (dropped).
+int fpf_push_text(
+    fpf_text_queue *const   p_queue,    // [in/out] Queue to push to.
+    const float             x,          // [in]     Left edge of the text in pixels.
+    const float             y,          // [in]     Top edge of the text in pixels.
+    const unsigned int      color,      // [in]     Text color; copied into each vertex.
+    const char *const       text        // [in]     Null-terminated text; cut at FPF_TEXT_RECORD_CHARS.
+    )
+{
+    size_t position;
+    fpf_text_queue_slot *p_slot;
+    unsigned int length = 0;
+
+    FPF_PROFILE_BEGIN("fpf_push_text");
+    FPF_assert(NULL != p_queue);
+    FPF_assert(NULL != text);
+
+    position = FPF_atomic_load(&p_queue->push_position, relaxed);
+
+    // Claim a free slot.
+    for (;;)
+    {
+        size_t sequence;
+
+        p_slot = &p_queue->slots[position & (FPF_TEXT_QUEUE_CAPACITY - 1)];
+        sequence = FPF_atomic_load(&p_slot->sequence, acquire);
+
+        if (sequence == position) // if (the slot is free)
+        {
+            if (FPF_atomic_compare_exchange_weak(&p_queue->push_position, &position, position + 1, relaxed))
+            {
+                break;
+            }
+        }
+        else if ((ptrdiff_t)(sequence - position) < 0) // if (the queue is full)
+        {
+            FPF_atomic_fetch_add(&p_queue->dropped_count, 1, relaxed);
+            FPF_PROFILE_END("fpf_push_text");
+            return 0;
+        }
+        else // Another producer claimed the slot first.
+        {
+            position = FPF_atomic_load(&p_queue->push_position, relaxed);
+        }
+    }
+
+    // Fill in the record, then hand it to the consumer.
+    while (length < FPF_TEXT_RECORD_CHARS && '\0' != text[length])
+    {
+        p_slot->record.text[length] = text[length];
+        ++length;
+    }
+
+    p_slot->record.x = x;
+    p_slot->record.y = y;
+    p_slot->record.color = color;
+    p_slot->record.length = length;
+
+    FPF_atomic_store(&p_slot->sequence, position + 1, release);
+    FPF_PROFILE_END("fpf_push_text");
+    return 1;
+}
+
+// Lays out all the text waiting in the queue into one batch of glyph quads (see
+// fpf_layout_text()). Only one thread may drain a queue. Records that don't fit in the vertex
+// buffer stay in the queue for the next drain, except a record too long for the whole buffer,
+// which is cut to fit (otherwise it would block the queue for good). A buffer too small for a
+// single glyph drains nothing.
+// Returns: the number of vertices written.
+size_t fpf_drain_text_queue(
+    fpf_text_queue *const       p_queue,            // [in/out] Queue to drain.
+    const fpf_y_axis_direction  y_axis_direction,   // [in]     Direction of the texture's y-axis.
+    fpf_vertex *const           p_vertices,         // [out]    Vertex buffer to fill.
+    const size_t                max_vertices        // [in]     Capacity of the vertex buffer in vertices.
+    )
+{
+    size_t vertex_count = 0;
+
+    FPF_PROFILE_BEGIN("fpf_drain_text_queue");
+    FPF_assert(NULL != p_queue);
+    FPF_assert(NULL != p_vertices || 0 == max_vertices);
+
+    if (max_vertices < FPF_VERTICES_PER_GLYPH) // if (not even one glyph fits, so leave everything queued)
+    {
+        FPF_PROFILE_END("fpf_drain_text_queue");
+        return 0;
+    }
+
+    for (;;)
+    {
+        const size_t position = p_queue->drain_position;
+        fpf_text_queue_slot *const p_slot = &p_queue->slots[position & (FPF_TEXT_QUEUE_CAPACITY - 1)];
+        const fpf_text_record *const p_record = &p_slot->record;
+
+        if (FPF_atomic_load(&p_slot->sequence, acquire) != position + 1) // if (nothing more is ready)
+        {
+            break;
+        }
+
+        if (0 != vertex_count &&
+            vertex_count + p_record->length * FPF_VERTICES_PER_GLYPH > max_vertices) // if (it might not fit)
+        {
+            break;
+        }
+
+        vertex_count += fpf_layout_text(
+            p_record->text,
+            p_record->length,
+            p_record->x,
+            p_record->y,
+            p_record->color,
+            y_axis_direction,
+            &p_vertices[vertex_count],
+            max_vertices - vertex_count);
+
+        // Give the slot back to the producers.
+        FPF_atomic_store(&p_slot->sequence, position + FPF_TEXT_QUEUE_CAPACITY, release);
+        p_queue->drain_position = position + 1;
+    }
+
+    FPF_PROFILE_END("fpf_drain_text_queue");
+    return vertex_count;
+}
+
+// Gets the number of records dropped (because the queue was full) since the last call.
+size_t fpf_take_text_queue_dropped_count(
+    fpf_text_queue *const p_queue   // [in/out] Queue to check.
+    )
+{
+    FPF_assert(NULL != p_queue);
+    return FPF_atomic_exchange(&p_queue->dropped_count, 0, relaxed);
+}
+
+#endif // FPF_IMPLEMENTATION
+
+#endif // FPF_TEXT_QUEUE_H
@@ -0,0 +1,662 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: microbenchmarks
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Times every hot path in the library: texture creation (across line pitches and both y-axis
+// directions), glyph and cursor lookups, layout, conversion and software rendering. Each
+// benchmark is calibrated so one sample takes about a millisecond, warmed up, then sampled
+// repeatedly; the report gives percentiles of ns/op plus glyphs/s and bytes/s at the median.
+//
+// usage: fpf_bench [--json] [--repetitions N] [--min-time MS] [--filter TEXT]
+//
+//  --json          Writes the results as JSON (for tracking across versions) instead of a table.
+//  --repetitions   Number of timed samples per benchmark (default 31).
+//  --min-time      Minimum time of one sample in milliseconds (default 1).
+//  --filter        Only runs benchmarks whose name contains TEXT.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+#define MAX_BENCHMARKS  64
+#define MAX_SAMPLES     1001
+
+typedef struct benchmark benchmark;
+typedef void (*benchmark_function)(const benchmark* p_benchmark, size_t iterations);
+
+struct benchmark
+{
+    char                    name[64];
+    benchmark_function      run;
+    size_t                  line_pitch;         // For texture creation.
+    fpf_y_axis_direction    y_axis_direction;
+    double                  glyphs_per_op;      // 0 if glyphs don't mean anything for the benchmark.
+    double                  bytes_per_op;       // Bytes written (or read, for conversions) per op.
+};
+
+typedef struct
+{
+    size_t iterations;  // Ops per sample.
+    double min;         // ns/op.
+    double p50;
+    double p90;
+    double p99;
+    double mean;
+} benchmark_result;
+
+// Keeps the compiler from throwing away results.
+volatile unsigned int sink;
+
+unsigned char texture[1024 * FPF_TEXTURE_HEIGHT];
+unsigned char rg_texture[FPF_OUTLINE_TEXTURE_WIDTH * 2 * FPF_OUTLINE_TEXTURE_HEIGHT];
+unsigned char sdf_texture[FPF_SDF_TEXTURE_WIDTH(4) * FPF_SDF_TEXTURE_HEIGHT(4)];
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+unsigned char subpixel_masks[FPF_SUBPIXEL_MASKS_SIZE(4)];
+unsigned char surface[640 * 480];
+unsigned char scanline[128 * FPF_GLYPH_WIDTH];
+unsigned char glyph_indices[1024];
+fpf_vertex vertices[1024 * FPF_VERTICES_PER_GLYPH];
+
+const char characters[] = " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+
+// A page of console text: 16 lines of 63 characters plus a newline.
+char page[16 * 64 + 1];
+size_t page_glyph_count;
+
+// A 3840x2160 screen full of text at 4x (160 columns by 90 lines of 24x24 pixel cells).
+#define SCREEN_WIDTH    3840
+#define SCREEN_HEIGHT   2160
+#define SCREEN_SCALE    4
+#define SCREEN_COLUMNS  (SCREEN_WIDTH / (FPF_GLYPH_WIDTH * SCREEN_SCALE))
+#define SCREEN_LINES    (SCREEN_HEIGHT / (FPF_GLYPH_HEIGHT * SCREEN_SCALE))
+char screen_text[SCREEN_LINES * (SCREEN_COLUMNS + 1)];
+size_t screen_glyph_count;
+unsigned char* p_screen;
+unsigned char* p_small_screen;
+
+// The same page with a few non-ASCII characters on each line.
+char utf8_page[16 * 80 + 1];
+size_t utf8_page_length;
+
+double GetSeconds()
+{
+#ifdef WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+void CreateTexture(const benchmark* p_benchmark, size_t iterations)
+{
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_create_alpha_texture(texture, sizeof(texture), p_benchmark->line_pitch, p_benchmark->y_axis_direction);
+    }
+}
+
+void CreateTextureStreaming(const benchmark* p_benchmark, size_t iterations)
+{
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_create_alpha_texture_streaming(texture, sizeof(texture), p_benchmark->line_pitch,
+            p_benchmark->y_axis_direction);
+    }
+}
+
+void CreatePartialTexture(const benchmark* p_benchmark, size_t iterations)
+{
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_create_partial_alpha_texture(texture, sizeof(texture), p_benchmark->line_pitch,
+            p_benchmark->y_axis_direction, "0123456789:", 11);
+    }
+}
+
+void CreateOutlineTexture(const benchmark* p_benchmark, size_t iterations)
+{
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_create_outline_texture(rg_texture, sizeof(rg_texture), p_benchmark->line_pitch,
+            p_benchmark->y_axis_direction);
+    }
+}
+
+void CreateShadowTexture(const benchmark* p_benchmark, size_t iterations)
+{
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_create_shadow_texture(rg_texture, sizeof(rg_texture), p_benchmark->line_pitch,
+            p_benchmark->y_axis_direction);
+    }
+}
+
+// The distance field atlas is measured at its own (tight) pitch; only the spread changes its cost.
+void CreateSdfTexture(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_create_sdf_texture(sdf_texture, sizeof(sdf_texture), FPF_SDF_TEXTURE_WIDTH(4),
+            FPF_RASTER_Y_AXIS, 4);
+    }
+}
+
+void CreateGlyphBits(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        fpf_create_glyph_bits(glyph_bits);
+        sink += glyph_bits[iterations % FPF_GLYPH_BITS_SIZE];
+    }
+}
+
+void GlyphPosition(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        unsigned int x, y;
+        fpf_get_glyph_position(characters[iterations % (sizeof(characters) - 1)], &x, &y);
+        sink += x + y;
+    }
+}
+
+void GlyphTextureCoordinates(const benchmark* p_benchmark, size_t iterations)
+{
+    while (iterations--)
+    {
+        float left, top, right, bottom;
+        const char character = characters[iterations % (sizeof(characters) - 1)];
+        if (FPF_RASTER_Y_AXIS == p_benchmark->y_axis_direction)
+        {
+            fpf_get_glyph_dx_texture_coordinates(character, &left, &top, &right, &bottom);
+        }
+        else
+        {
+            fpf_get_glyph_gl_texture_coordinates(character, &left, &top, &right, &bottom);
+        }
+        sink += (unsigned int)((left + top + right + bottom) * 64.0f);
+    }
+}
+
+void CursorPosition(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        unsigned int x, y;
+        fpf_get_cursor_glyph_position((fpf_cursor_style)(iterations % 3), &x, &y);
+        sink += x + y;
+    }
+}
+
+void CursorTextureCoordinates(const benchmark* p_benchmark, size_t iterations)
+{
+    while (iterations--)
+    {
+        float left, top, right, bottom;
+        if (FPF_RASTER_Y_AXIS == p_benchmark->y_axis_direction)
+        {
+            fpf_get_cursor_glyph_dx_texture_coordinates((fpf_cursor_style)(iterations % 3), &left, &top, &right, &bottom);
+        }
+        else
+        {
+            fpf_get_cursor_glyph_gl_texture_coordinates((fpf_cursor_style)(iterations % 3), &left, &top, &right, &bottom);
+        }
+        sink += (unsigned int)((left + top + right + bottom) * 64.0f);
+    }
+}
+
+void LayoutText(const benchmark* p_benchmark, size_t iterations)
+{
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_layout_text(page, sizeof(page) - 1, 0.0f, 0.0f, 0xffffffffu,
+            p_benchmark->y_axis_direction, vertices, sizeof(vertices) / sizeof(vertices[0]));
+    }
+}
+
+void LayoutTextClipped(const benchmark* p_benchmark, size_t iterations)
+{
+    // The top-left quarter of the page.
+    const fpf_clip_rect clip = { 0, 0, 32 * FPF_GLYPH_WIDTH, 8 * FPF_GLYPH_HEIGHT };
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_layout_text_clipped(page, sizeof(page) - 1, 0.0f, 0.0f, 0xffffffffu,
+            p_benchmark->y_axis_direction, &clip, vertices, sizeof(vertices) / sizeof(vertices[0]), NULL);
+    }
+}
+
+void LayoutUtf8Text(const benchmark* p_benchmark, size_t iterations)
+{
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_layout_utf8_text(utf8_page, utf8_page_length, 0.0f, 0.0f, 0xffffffffu,
+            p_benchmark->y_axis_direction, vertices, sizeof(vertices) / sizeof(vertices[0]));
+    }
+}
+
+void ConvertAscii(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_utf8_to_glyph_indices(page, sizeof(page) - 1, NULL, 0, glyph_indices,
+            sizeof(glyph_indices), NULL);
+    }
+}
+
+void ConvertUtf8(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_utf8_to_glyph_indices(utf8_page, utf8_page_length, NULL, 0, glyph_indices,
+            sizeof(glyph_indices), NULL);
+    }
+}
+
+void DrawTextAlpha8(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_draw_text_alpha8(glyph_bits, surface, 640, 480, 640, 8, 8, page, sizeof(page) - 1, 0xff);
+    }
+}
+
+void DrawTextAlpha8Subpixel(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_draw_text_alpha8_subpixel(subpixel_masks, 4, surface, 640, 480, 640, 8.25f, 8, page,
+            sizeof(page) - 1, 0xff);
+    }
+}
+
+void RenderScanline(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        // A whole 128 character row of text, one scanline at a time.
+        for (unsigned int k = 0; k < FPF_GLYPH_HEIGHT; ++k)
+        {
+            sink += (unsigned int)fpf_render_text_scanline(page, 128, k, FPF_8BPP, 0xff, 0x00, scanline, sizeof(scanline));
+        }
+    }
+}
+
+void DrawScreenAlpha8Scaled(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_draw_text_alpha8_scaled(glyph_bits, p_screen, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_WIDTH,
+            0, 0, screen_text, sizeof(screen_text), 0xff, SCREEN_SCALE);
+    }
+}
+
+void DrawScreenRgba32Scaled(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        sink += (unsigned int)fpf_draw_text_rgba32_scaled(glyph_bits, p_screen, SCREEN_WIDTH, SCREEN_HEIGHT,
+            SCREEN_WIDTH * 4, 0, 0, screen_text, sizeof(screen_text), 0xff00ff00u, SCREEN_SCALE);
+    }
+}
+
+// The alternative: draw at 1x, then blow the whole frame up with a nearest-neighbor resampler.
+void DrawScreenThenResample(const benchmark* p_benchmark, size_t iterations)
+{
+    (void)(p_benchmark);
+    while (iterations--)
+    {
+        const unsigned int small_width = SCREEN_WIDTH / SCREEN_SCALE;
+        sink += (unsigned int)fpf_draw_text_alpha8(glyph_bits, p_small_screen, small_width, SCREEN_HEIGHT / SCREEN_SCALE,
+            small_width, 0, 0, screen_text, sizeof(screen_text), 0xff);
+        for (unsigned int y = 0; y < SCREEN_HEIGHT; ++y)
+        {
+            const unsigned char* const p_src = &p_small_screen[(y / SCREEN_SCALE) * small_width];
+            unsigned char* const p_dst = &p_screen[y * SCREEN_WIDTH];
+            for (unsigned int x = 0; x < SCREEN_WIDTH; ++x)
+            {
+                p_dst[x] = p_src[x / SCREEN_SCALE];
+            }
+        }
+    }
+}
+
+size_t benchmark_count;
+benchmark benchmarks[MAX_BENCHMARKS];
+
+// Benchmarks that don't depend on the y-axis direction pass NO_DIRECTION.
+#define NO_DIRECTION ((fpf_y_axis_direction)-1)
+
+void AddBenchmark(const char* name, benchmark_function run, size_t line_pitch,
+    fpf_y_axis_direction y_axis_direction, double glyphs_per_op, double bytes_per_op)
+{
+    benchmark* const p = &benchmarks[benchmark_count++];
+    const char* const direction_name =
+        (NO_DIRECTION == y_axis_direction) ? "" : (FPF_RASTER_Y_AXIS == y_axis_direction) ? "/raster" : "/vector";
+    if (0 != line_pitch)
+    {
+        snprintf(p->name, sizeof(p->name), "%s/pitch:%u%s", name, (unsigned int)line_pitch, direction_name);
+    }
+    else
+    {
+        snprintf(p->name, sizeof(p->name), "%s%s", name, direction_name);
+    }
+    p->run = run;
+    p->line_pitch = line_pitch;
+    p->y_axis_direction = y_axis_direction;
+    p->glyphs_per_op = glyphs_per_op;
+    p->bytes_per_op = bytes_per_op;
+}
+
+void AddBenchmarks()
+{
+    const size_t pitches[] = { FPF_TEXTURE_WIDTH, 128, 256, 1024 };
+    const fpf_y_axis_direction directions[] = { FPF_RASTER_Y_AXIS, FPF_VECTOR_Y_AXIS };
+    const double atlas_bytes = FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT;
+    const double rg_bytes = FPF_TEXTURE_WIDTH * 2 * FPF_TEXTURE_HEIGHT;
+    const double outline_bytes = FPF_OUTLINE_TEXTURE_WIDTH * 2 * FPF_OUTLINE_TEXTURE_HEIGHT;
+
+    for (unsigned int j = 0; j < 2; ++j)
+    {
+        for (unsigned int k = 0; k < sizeof(pitches) / sizeof(pitches[0]); ++k)
+        {
+            AddBenchmark("create_alpha_texture", CreateTexture, pitches[k], directions[j], FPF_GLYPH_COUNT, atlas_bytes);
+        }
+        for (unsigned int k = 0; k < sizeof(pitches) / sizeof(pitches[0]); ++k)
+        {
+            AddBenchmark("create_alpha_texture_streaming", CreateTextureStreaming, pitches[k], directions[j],
+                FPF_GLYPH_COUNT, atlas_bytes);
+        }
+        AddBenchmark("create_partial_alpha_texture", CreatePartialTexture, FPF_TEXTURE_WIDTH, directions[j], 12,
+            12 * FPF_GLYPH_WIDTH * FPF_GLYPH_HEIGHT);
+        AddBenchmark("create_outline_texture", CreateOutlineTexture, FPF_OUTLINE_TEXTURE_WIDTH * 2, directions[j],
+            FPF_GLYPH_COUNT, outline_bytes);
+        AddBenchmark("create_shadow_texture", CreateShadowTexture, FPF_TEXTURE_WIDTH * 2, directions[j],
+            FPF_GLYPH_COUNT, rg_bytes);
+    }
+
+    AddBenchmark("create_sdf_texture/spread:4", CreateSdfTexture, 0, NO_DIRECTION, FPF_GLYPH_COUNT,
+        sizeof(sdf_texture));
+    AddBenchmark("create_glyph_bits", CreateGlyphBits, 0, NO_DIRECTION, FPF_GLYPH_COUNT, FPF_GLYPH_BITS_SIZE);
+    AddBenchmark("get_glyph_position", GlyphPosition, 0, NO_DIRECTION, 1, 0);
+    AddBenchmark("get_cursor_glyph_position", CursorPosition, 0, NO_DIRECTION, 1, 0);
+
+    for (unsigned int j = 0; j < 2; ++j)
+    {
+        AddBenchmark("get_glyph_texture_coordinates", GlyphTextureCoordinates, 0, directions[j], 1, 0);
+        AddBenchmark("get_cursor_glyph_texture_coordinates", CursorTextureCoordinates, 0, directions[j], 1, 0);
+        AddBenchmark("layout_text", LayoutText, 0, directions[j], (double)page_glyph_count,
+            (double)page_glyph_count * FPF_VERTICES_PER_GLYPH * sizeof(fpf_vertex));
+        AddBenchmark("layout_text_clipped", LayoutTextClipped, 0, directions[j], (double)page_glyph_count / 4,
+            (double)page_glyph_count / 4 * FPF_VERTICES_PER_GLYPH * sizeof(fpf_vertex));
+        AddBenchmark("layout_utf8_text", LayoutUtf8Text, 0, directions[j], (double)page_glyph_count,
+            (double)page_glyph_count * FPF_VERTICES_PER_GLYPH * sizeof(fpf_vertex));
+    }
+
+    // Conversions are measured by the bytes of text read.
+    AddBenchmark("utf8_to_glyph_indices/ascii", ConvertAscii, 0, NO_DIRECTION, sizeof(page) - 1, sizeof(page) - 1);
+    AddBenchmark("utf8_to_glyph_indices/mixed", ConvertUtf8, 0, NO_DIRECTION, sizeof(page) - 1, (double)utf8_page_length);
+
+    // Software rendering is measured by the bytes of surface covered.
+    AddBenchmark("draw_text_alpha8", DrawTextAlpha8, 0, NO_DIRECTION, (double)page_glyph_count,
+        16.0 * 64 * FPF_GLYPH_WIDTH * FPF_GLYPH_HEIGHT);
+    AddBenchmark("draw_text_alpha8_subpixel/4", DrawTextAlpha8Subpixel, 0, NO_DIRECTION, (double)page_glyph_count,
+        16.0 * 64 * FPF_GLYPH_WIDTH * FPF_GLYPH_HEIGHT);
+
+    // A whole 4K screen of text at 4x.
+    const double screen_pixels = (double)SCREEN_WIDTH * SCREEN_HEIGHT;
+    AddBenchmark("draw_text_alpha8_scaled/x4/3840x2160", DrawScreenAlpha8Scaled, 0, NO_DIRECTION,
+        (double)screen_glyph_count, screen_pixels);
+    AddBenchmark("draw_text_rgba32_scaled/x4/3840x2160", DrawScreenRgba32Scaled, 0, NO_DIRECTION,
+        (double)screen_glyph_count, screen_pixels * 4);
+    AddBenchmark("draw_text_alpha8_then_resample/x4/3840x2160", DrawScreenThenResample, 0, NO_DIRECTION,
+        (double)screen_glyph_count, screen_pixels);
+    AddBenchmark("render_text_scanline/8bpp", RenderScanline, 0, NO_DIRECTION, 128, sizeof(scanline) * FPF_GLYPH_HEIGHT);
+}
+
+void MakeText()
+{
+    char* p = utf8_page;
+    for (unsigned int line = 0; line < 16; ++line)
+    {
+        for (unsigned int column = 0; column < 63; ++column)
+        {
+            const char character = (0 == (column + line) % 7) ? ' ' : characters[1 + (line * 63 + column) % (sizeof(characters) - 2)];
+            page[line * 64 + column] = character;
+            page_glyph_count += (' ' != character);
+
+            // Every 16th character becomes a 2-byte "e with acute accent".
+            if (0 == column % 16)
+            {
+                *p++ = '\xc3';
+                *p++ = '\xa9';
+            }
+            else
+            {
+                *p++ = character;
+            }
+        }
+        page[line * 64 + 63] = '\n';
+        *p++ = '\n';
+    }
+    page[sizeof(page) - 1] = '\0';
+
+    for (unsigned int line = 0; line < SCREEN_LINES; ++line)
+    {
+        for (unsigned int column = 0; column < SCREEN_COLUMNS; ++column)
+        {
+            const char character = (0 == (column + line) % 7) ? ' ' : characters[1 + (line * 31 + column) % (sizeof(characters) - 2)];
+            screen_text[line * (SCREEN_COLUMNS + 1) + column] = character;
+            screen_glyph_count += (' ' != character);
+        }
+        screen_text[line * (SCREEN_COLUMNS + 1) + SCREEN_COLUMNS] = '\n';
+    }
+    utf8_page_length = (size_t)(p - utf8_page);
+}
+
+int CompareDoubles(const void* p_a, const void* p_b)
+{
+    const double a = *(const double*)p_a;
+    const double b = *(const double*)p_b;
+    return (a > b) - (a < b);
+}
+
+// Nearest-rank percentile of sorted samples.
+double Percentile(const double* samples, const size_t count, const double fraction)
+{
+    size_t rank = (size_t)(fraction * (double)count + 0.999999);
+    rank = (rank < 1) ? 1 : (rank > count) ? count : rank;
+    return samples[rank - 1];
+}
+
+benchmark_result RunBenchmark(const benchmark* p_benchmark, const unsigned int repetitions, const double min_seconds)
+{
+    static double samples[MAX_SAMPLES];
+    benchmark_result result;
+    size_t iterations = 1;
+    double elapsed = 0.0;
+
+    // Calibrate (which also warms up the caches and branch predictors), then warm up a bit longer.
+    for (;;)
+    {
+        const double start = GetSeconds();
+        p_benchmark->run(p_benchmark, iterations);
+        elapsed = GetSeconds() - start;
+        if (elapsed >= min_seconds)
+        {
+            break;
+        }
+        iterations *= (elapsed < min_seconds / 8) ? 8 : 2;
+    }
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        p_benchmark->run(p_benchmark, iterations);
+    }
+
+    double total = 0.0;
+    for (unsigned int i = 0; i < repetitions; ++i)
+    {
+        const double start = GetSeconds();
+        p_benchmark->run(p_benchmark, iterations);
+        samples[i] = (GetSeconds() - start) * 1e9 / (double)iterations;
+        total += samples[i];
+    }
+    qsort(samples, repetitions, sizeof(samples[0]), CompareDoubles);
+
+    result.iterations = iterations;
+    result.min = samples[0];
+    result.p50 = Percentile(samples, repetitions, 0.50);
+    result.p90 = Percentile(samples, repetitions, 0.90);
+    result.p99 = Percentile(samples, repetitions, 0.99);
+    result.mean = total / repetitions;
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int json = 0;
+    unsigned int repetitions = 31;
+    double min_seconds = 0.001;
+    const char* filter = NULL;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (0 == strcmp(argv[i], "--json"))
+        {
+            json = 1;
+        }
+        else if (0 == strcmp(argv[i], "--repetitions") && i + 1 < argc)
+        {
+            repetitions = (unsigned int)atoi(argv[++i]);
+        }
+        else if (0 == strcmp(argv[i], "--min-time") && i + 1 < argc)
+        {
+            min_seconds = atof(argv[++i]) * 1e-3;
+        }
+        else if (0 == strcmp(argv[i], "--filter") && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--json] [--repetitions N] [--min-time MS] [--filter TEXT]\n", argv[0]);
+            return 1;
+        }
+    }
+    repetitions = (repetitions < 1) ? 1 : (repetitions > MAX_SAMPLES) ? MAX_SAMPLES : repetitions;
+
+    MakeText();
+    p_screen = (unsigned char*)calloc((size_t)SCREEN_WIDTH * SCREEN_HEIGHT, 4);
+    p_small_screen = (unsigned char*)calloc((size_t)SCREEN_WIDTH * SCREEN_HEIGHT / (SCREEN_SCALE * SCREEN_SCALE), 1);
+    fpf_create_glyph_bits(glyph_bits);
+    fpf_create_subpixel_masks(subpixel_masks, sizeof(subpixel_masks), 4);
+    AddBenchmarks();
+
+#if defined(FPF_AVX2)
+    const char* const simd = "avx2";
+#elif defined(FPF_SSE2)
+    const char* const simd = "sse2";
+#else
+    const char* const simd = "none";
+#endif
+
+    if (json)
+    {
+        printf("{\n  \"library\": \"five-pixel-font\",\n  \"simd\": \"%s\",\n  \"repetitions\": %u,\n  \"benchmarks\": [", simd, repetitions);
+    }
+    else
+    {
+        printf("simd: %s, %u repetitions\n", simd, repetitions);
+        printf("%-58s %10s %10s %10s %10s %12s %12s\n", "benchmark", "min ns/op", "p50 ns/op", "p90 ns/op", "p99 ns/op", "Mglyphs/s", "MB/s");
+    }
+
+    int first = 1;
+    for (size_t i = 0; i < benchmark_count; ++i)
+    {
+        const benchmark* const p_benchmark = &benchmarks[i];
+        if (NULL != filter && NULL == strstr(p_benchmark->name, filter))
+        {
+            continue;
+        }
+
+        const benchmark_result result = RunBenchmark(p_benchmark, repetitions, min_seconds);
+        const double glyphs_per_second = p_benchmark->glyphs_per_op * 1e9 / result.p50;
+        const double bytes_per_second = p_benchmark->bytes_per_op * 1e9 / result.p50;
+
+        if (json)
+        {
+            printf("%s\n    {\"name\": \"%s\", \"iterations\": %lu, \"ns_per_op\": {\"min\": %.3f, \"p50\": %.3f, \"p90\": %.3f, "
+                "\"p99\": %.3f, \"mean\": %.3f}, \"glyphs_per_second\": %.0f, \"bytes_per_second\": %.0f}",
+                first ? "" : ",", p_benchmark->name, (unsigned long)result.iterations,
+                result.min, result.p50, result.p90, result.p99, result.mean, glyphs_per_second, bytes_per_second);
+        }
+        else
+        {
+            printf("%-58s %10.1f %10.1f %10.1f %10.1f %12.1f %12.1f\n", p_benchmark->name,
+                result.min, result.p50, result.p90, result.p99, glyphs_per_second * 1e-6, bytes_per_second * 1e-6);
+        }
+        fflush(stdout);
+        first = 0;
+    }
+
+    if (json)
+    {
+        printf("\n  ]\n}\n");
+    }
+
+    free(p_screen);
+    free(p_small_screen);
+    return (int)(sink & 0);
+}
@@ -0,0 +1,239 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: delta-encoded cell stream test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Mirrors a made-up status dashboard (a clock, counters, a scrolling log, color changes, a moving
+// cursor and one resize) from a forked sender process to this one over a pipe. The receiver reads
+// the stream in small, uneven pieces and checks every decoded frame against the same frame made
+// locally, then reports bytes per frame against sending whole frames.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define FPF_IMPLEMENTATION
+#include "fpf_cell_stream.h"
+
+#define FRAME_COUNT     300
+#define RESIZE_FRAME    200
+#define LOG_ROWS        16
+
+enum { TEXT_COLOR, TITLE_COLOR, OK_COLOR, WARN_COLOR, COLOR_COUNT };
+
+fpf_cell_grid frame;
+fpf_cell_encoder encoder;
+fpf_cell_decoder decoder;
+unsigned char stream[FPF_CELL_STREAM_MAX_FRAME_SIZE(FPF_CELL_GRID_MAX_CELLS)];
+unsigned char pending[FPF_CELL_STREAM_MAX_FRAME_SIZE(FPF_CELL_GRID_MAX_CELLS) + 64];
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+unsigned char surface[30 * FPF_GLYPH_HEIGHT][100 * FPF_GLYPH_WIDTH];
+fpf_vertex vertices[FPF_CELL_GRID_MAX_CELLS * FPF_VERTICES_PER_GLYPH];
+
+// Builds frame number n of the dashboard from scratch.
+void MakeFrame(fpf_cell_grid* p_grid, unsigned int n)
+{
+    char text[128];
+    const unsigned int columns = (n < RESIZE_FRAME) ? 80 : 100;
+    const unsigned int rows = (n < RESIZE_FRAME) ? 25 : 30;
+    const int warning = (n / 50) % 2;
+
+    fpf_init_cell_grid(p_grid, columns, rows);
+    fpf_write_cell_text(p_grid, 0, 0, TITLE_COLOR, "==== unit 7 dashboard ========================", 46);
+    fpf_write_cell_text(p_grid, 0, 1, TEXT_COLOR, text,
+                        (size_t)snprintf(text, sizeof(text), "uptime %02u:%02u:%02u   frames %6u   fps %5.2f",
+                                         n / 3600, n / 60 % 60, n % 60, n * 3, 59.5 + (n % 7) * 0.07));
+    fpf_write_cell_text(p_grid, 0, 2, TEXT_COLOR, text,
+                        (size_t)snprintf(text, sizeof(text), "cpu %3u%%   mem %5u KB   queue %3u",
+                                         (n * 37) % 101, 40000 + (n / 10) * 16, (n * 13) % 17));
+    fpf_write_cell_text(p_grid, 0, 3, TEXT_COLOR, "status:", 7);
+    fpf_write_cell_text(p_grid, 8, 3, warning ? WARN_COLOR : OK_COLOR, warning ? "WARN" : "OK  ", 4);
+
+    // The log gets a new line every 10 frames and scrolls up.
+    for (unsigned int row = 0; row < LOG_ROWS; ++row)
+    {
+        const unsigned int line = n / 10 + row;
+        fpf_write_cell_text(p_grid, 2, 5 + row, (0 == line % 5) ? WARN_COLOR : TEXT_COLOR, text,
+                            (size_t)snprintf(text, sizeof(text), "[%05u] job %u finished in %u ms", line * 10, line,
+                                             (line * 7919) % 1000));
+    }
+
+    fpf_write_cell_text(p_grid, 0, rows - 1, TEXT_COLOR, "> ", 2);
+    fpf_write_cell_text(p_grid, 2, rows - 1, TEXT_COLOR, "restart encoder", n % 16);
+    fpf_set_cell_cursor(p_grid, 2 + n % 16, rows - 1, (0 == (n / 30) % 2) ? FPF_BLOCK_CURSOR : FPF_UNDERLINE_CURSOR);
+}
+
+int Send(int fd)
+{
+    fpf_init_cell_encoder(&encoder);
+
+    for (unsigned int n = 0; n < FRAME_COUNT; ++n)
+    {
+        MakeFrame(&frame, n);
+        const size_t byte_count = fpf_encode_cell_frame(&encoder, &frame, stream, sizeof(stream));
+        if (0 == byte_count || byte_count != (size_t)write(fd, stream, byte_count))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    int fds[2];
+    size_t pending_size = 0;
+    size_t frame_bytes = 0;
+    size_t total_bytes = 0;
+    size_t min_bytes = (size_t)-1;
+    size_t max_bytes = 0;
+    size_t full_bytes = 0;
+    unsigned int frames = 0;
+    unsigned int chunk = 1;
+    int failed = 0;
+
+    if (0 != pipe(fds))
+    {
+        printf("pipe() failed\nFAILED\n");
+        return 1;
+    }
+
+    const pid_t sender = fork();
+    if (0 == sender)
+    {
+        close(fds[0]);
+        _exit(Send(fds[1]));
+    }
+    close(fds[1]);
+
+    fpf_init_cell_decoder(&decoder, COLOR_COUNT);
+
+    for (;;)
+    {
+        // Read a small, uneven piece, so opcodes get cut off at the end of the data.
+        chunk = chunk * 7 % 61 + 1;
+        const ssize_t read_count = read(fds[0], &pending[pending_size], chunk);
+        if (read_count <= 0)
+        {
+            break;
+        }
+        pending_size += (size_t)read_count;
+
+        for (;;)
+        {
+            size_t bytes_used;
+            const int result = fpf_decode_cell_stream(&decoder, pending, pending_size, &bytes_used);
+
+            memmove(pending, &pending[bytes_used], pending_size - bytes_used);
+            pending_size -= bytes_used;
+            frame_bytes += bytes_used;
+
+            if (FPF_CELL_STREAM_ERROR == result)
+            {
+                printf("malformed stream at frame %u\n", frames);
+                failed = 1;
+                break;
+            }
+
+            if (FPF_CELL_STREAM_MORE == result)
+            {
+                break;
+            }
+
+            // A frame is done; it has to match the one the sender made.
+            MakeFrame(&frame, frames);
+            if (decoder.grid.columns != frame.columns || decoder.grid.rows != frame.rows ||
+                0 != memcmp(decoder.grid.characters, frame.characters, frame.columns * frame.rows) ||
+                0 != memcmp(decoder.grid.colors, frame.colors, frame.columns * frame.rows) ||
+                decoder.grid.cursor_cell != frame.cursor_cell || decoder.grid.cursor_style != frame.cursor_style)
+            {
+                printf("frame %u DIFFERS\n", frames);
+                failed = 1;
+            }
+
+            total_bytes += frame_bytes;
+            full_bytes += 2 * frame.columns * frame.rows;
+            min_bytes = (frame_bytes < min_bytes) ? frame_bytes : min_bytes;
+            max_bytes = (frame_bytes > max_bytes) ? frame_bytes : max_bytes;
+            frame_bytes = 0;
+            ++frames;
+        }
+
+        if (failed)
+        {
+            break;
+        }
+    }
+
+    int status = 0;
+    waitpid(sender, &status, 0);
+    if (!WIFEXITED(status) || 0 != WEXITSTATUS(status) || FRAME_COUNT != frames || 0 != pending_size)
+    {
+        failed = 1;
+    }
+
+    printf("%u frames, %zu bytes: %.1f bytes/frame (min %zu, max %zu); a character and color per cell would take %.1f\n",
+           frames, total_bytes, (double)total_bytes / frames, min_bytes, max_bytes, (double)full_bytes / frames);
+
+    // The mirrored grid draws the same in software and as vertices.
+    fpf_create_glyph_bits(glyph_bits);
+    const size_t glyph_count = fpf_draw_cell_grid_alpha8(&decoder.grid, glyph_bits, &surface[0][0],
+                                                         sizeof(surface[0]), sizeof(surface) / sizeof(surface[0]),
+                                                         sizeof(surface[0]), 0, 0, NULL);
+    const size_t vertex_count = fpf_layout_cell_grid(&decoder.grid, 0.0f, 0.0f, NULL, FPF_RASTER_Y_AXIS, vertices,
+                                                     sizeof(vertices) / sizeof(vertices[0]));
+    printf("last frame: %zu glyphs drawn, %zu vertices laid out\n", glyph_count, vertex_count);
+    if (0 == glyph_count || glyph_count * FPF_VERTICES_PER_GLYPH != vertex_count)
+    {
+        failed = 1;
+    }
+
+    // Bad opcodes, writes past the end of the grid and colors past the end of the palette are errors.
+    const unsigned char bad_opcode[] = { FPF_CELL_OP_RESET, 2, 2, 0x3f };
+    const unsigned char bad_color[] = { FPF_CELL_OP_RESET, 2, 2, FPF_CELL_OP_COLOR, COLOR_COUNT, FPF_CELL_OP_TEXT, 'a' };
+    const unsigned char overrun[] = { FPF_CELL_OP_RESET, 2, 2, FPF_CELL_OP_SKIP, 3, FPF_CELL_OP_TEXT + 1, 'a', 'b' };
+    size_t bytes_used;
+    fpf_init_cell_decoder(&decoder, COLOR_COUNT);
+    if (FPF_CELL_STREAM_ERROR != fpf_decode_cell_stream(&decoder, bad_opcode, sizeof(bad_opcode), &bytes_used) ||
+        FPF_CELL_STREAM_ERROR != fpf_decode_cell_stream(&decoder, overrun, sizeof(overrun), &bytes_used) ||
+        FPF_CELL_STREAM_ERROR != fpf_decode_cell_stream(&decoder, bad_color, sizeof(bad_color), &bytes_used) ||
+        3 != bytes_used)
+    {
+        printf("malformed streams weren't rejected\n");
+        failed = 1;
+    }
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
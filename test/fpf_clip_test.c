@@ -0,0 +1,168 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: clipping test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Lays out and draws a long scrolling console (thousands of lines) through a small clip rectangle
+// that cuts through glyphs on every edge. Checks the clipped results against the unclipped ones
+// (trimmed by hand), and times clipped against unclipped layout.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+#define LINE_COUNT      5000
+#define LINE_LENGTH     80
+#define SURFACE_WIDTH   320
+#define SURFACE_HEIGHT  240
+
+char text[LINE_COUNT * (LINE_LENGTH + 1)];
+fpf_vertex full_vertices[LINE_COUNT * LINE_LENGTH * FPF_VERTICES_PER_GLYPH];
+fpf_vertex clipped_vertices[LINE_COUNT * LINE_LENGTH * FPF_VERTICES_PER_GLYPH];
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+unsigned char full_surface[SURFACE_WIDTH * SURFACE_HEIGHT];
+unsigned char clipped_surface[SURFACE_WIDTH * SURFACE_HEIGHT];
+
+double GetSeconds()
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    int failed = 0;
+
+    for (unsigned int line = 0; line < LINE_COUNT; ++line)
+    {
+        for (unsigned int column = 0; column < LINE_LENGTH; ++column)
+        {
+            text[line * (LINE_LENGTH + 1) + column] = (0 == (line + column) % 9) ? ' ' : (char)('!' + (line * 7 + column) % 94);
+        }
+        text[line * (LINE_LENGTH + 1) + LINE_LENGTH] = '\n';
+    }
+
+    // The console is scrolled so line 2000 is at the top; the view cuts glyphs on every side.
+    const float x = -3.0f;
+    const float y = -2000.0f * FPF_GLYPH_HEIGHT;
+    const fpf_clip_rect clip = { 17, 9, 200, 151 };
+
+    const size_t full_count = fpf_layout_text(text, sizeof(text), x, y, 0xffffffffu, FPF_VECTOR_Y_AXIS,
+        full_vertices, sizeof(full_vertices) / sizeof(full_vertices[0]));
+    size_t culled_count = 0;
+    const size_t clipped_count = fpf_layout_text_clipped(text, sizeof(text), x, y, 0xffffffffu, FPF_VECTOR_Y_AXIS, &clip,
+        clipped_vertices, sizeof(clipped_vertices) / sizeof(clipped_vertices[0]), &culled_count);
+
+    // Trim every quad of the unclipped layout by hand; the survivors should match, in order.
+    size_t expected_count = 0;
+    for (size_t i = 0; i < full_count; i += FPF_VERTICES_PER_GLYPH)
+    {
+        fpf_vertex quad[FPF_VERTICES_PER_GLYPH];
+        const fpf_vertex* const p = &full_vertices[i];
+        const float x0 = (p[0].x < clip.left) ? clip.left : p[0].x;
+        const float y0 = (p[0].y < clip.top) ? clip.top : p[0].y;
+        const float x1 = (p[5].x > clip.right) ? clip.right : p[5].x;
+        const float y1 = (p[5].y > clip.bottom) ? clip.bottom : p[5].y;
+        if (x0 >= x1 || y0 >= y1)
+        {
+            continue;
+        }
+
+        const float du = (p[5].u - p[0].u) / FPF_GLYPH_WIDTH;
+        const float dv = (p[5].v - p[0].v) / FPF_GLYPH_HEIGHT;
+        fpf_emit_quad(quad, x0, y0, x1, y1,
+            p[0].u + du * (x0 - p[0].x), p[0].v + dv * (y0 - p[0].y),
+            p[5].u - du * (p[5].x - x1), p[5].v - dv * (p[5].y - y1), p[0].color);
+
+        failed |= (expected_count >= clipped_count) ||
+            (0 != memcmp(quad, &clipped_vertices[expected_count], sizeof(quad)));
+        expected_count += FPF_VERTICES_PER_GLYPH;
+    }
+    failed |= (expected_count != clipped_count);
+
+    // 25 lines are visible (two of them partly), 31 characters of each (two of them partly).
+    failed |= (culled_count != LINE_COUNT * LINE_LENGTH - 25 * 31);
+    printf("layout: %u of %u glyphs inside, %u characters culled\n", (unsigned int)(clipped_count / FPF_VERTICES_PER_GLYPH),
+        (unsigned int)(full_count / FPF_VERTICES_PER_GLYPH), (unsigned int)culled_count);
+
+    // A buffer that fills early stops emitting quads but still counts the lines after it.
+    size_t short_culled_count = 0;
+    const size_t short_count = fpf_layout_text_clipped(text, sizeof(text), x, y, 0xffffffffu, FPF_VECTOR_Y_AXIS, &clip,
+        clipped_vertices, 10 * FPF_VERTICES_PER_GLYPH, &short_culled_count);
+    failed |= (10 * FPF_VERTICES_PER_GLYPH != short_count) || (short_culled_count != culled_count);
+    printf("short buffer: %u glyphs, %u characters culled\n", (unsigned int)(short_count / FPF_VERTICES_PER_GLYPH),
+        (unsigned int)short_culled_count);
+
+    // Software rendering through the same clip rectangle matches an unclipped draw with
+    // everything outside the rectangle erased.
+    fpf_create_glyph_bits(glyph_bits);
+    const int draw_y = 9 - 1000 * FPF_GLYPH_HEIGHT - 3;
+    fpf_draw_text_alpha8(glyph_bits, full_surface, SURFACE_WIDTH, SURFACE_HEIGHT, SURFACE_WIDTH, (int)x, draw_y,
+        text, sizeof(text), 0xff);
+    const size_t drawn = fpf_draw_text_alpha8_clipped(glyph_bits, clipped_surface, SURFACE_WIDTH, SURFACE_HEIGHT,
+        SURFACE_WIDTH, (int)x, draw_y, text, sizeof(text), 0xff, &clip, &culled_count);
+    for (int row = 0; row < SURFACE_HEIGHT; ++row)
+    {
+        for (int column = 0; column < SURFACE_WIDTH; ++column)
+        {
+            const int inside = column >= clip.left && column < clip.right && row >= clip.top && row < clip.bottom;
+            failed |= ((inside ? full_surface[row * SURFACE_WIDTH + column] : 0) != clipped_surface[row * SURFACE_WIDTH + column]);
+        }
+    }
+    printf("draw: %u glyphs drawn, %u characters culled\n", (unsigned int)drawn, (unsigned int)culled_count);
+
+    // Timing.
+    const unsigned int passes = 200;
+    double start = GetSeconds();
+    for (unsigned int pass = 0; pass < passes; ++pass)
+    {
+        fpf_layout_text(text, sizeof(text), x, y, 0xffffffffu, FPF_VECTOR_Y_AXIS,
+            full_vertices, sizeof(full_vertices) / sizeof(full_vertices[0]));
+    }
+    const double full_seconds = (GetSeconds() - start) / passes;
+    start = GetSeconds();
+    for (unsigned int pass = 0; pass < passes; ++pass)
+    {
+        fpf_layout_text_clipped(text, sizeof(text), x, y, 0xffffffffu, FPF_VECTOR_Y_AXIS, &clip,
+            clipped_vertices, sizeof(clipped_vertices) / sizeof(clipped_vertices[0]), NULL);
+    }
+    const double clipped_seconds = (GetSeconds() - start) / passes;
+    printf("%u lines: unclipped %.1f us, clipped %.1f us, %.0fx\n", LINE_COUNT, full_seconds * 1e6,
+        clipped_seconds * 1e6, full_seconds / clipped_seconds);
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
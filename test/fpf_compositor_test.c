@@ -0,0 +1,215 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: tile-binned multithreaded compositor test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Scatters hundreds of overlapping text boxes (some hanging off every edge) over a 3840x2160
+// surface, composites them with 1, 2, 4 and 8 worker threads, and checks every result is
+// bit-identical to drawing the boxes one after another with fpf_draw_text_alpha8(). It also
+// times each thread count.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#define FPF_IMPLEMENTATION
+#include "fpf_compositor.h"
+
+#define SURFACE_WIDTH   3840
+#define SURFACE_HEIGHT  2160
+#define COMMAND_COUNT   600
+#define MAX_THREADS     8
+#define REPETITIONS     20
+
+char texts[COMMAND_COUNT][256];
+fpf_draw_command commands[COMMAND_COUNT];
+fpf_draw_command extra_commands[FPF_COMPOSITOR_MAX_COMMANDS + 1];
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+unsigned char expected_surface[SURFACE_WIDTH * SURFACE_HEIGHT];
+unsigned char surface[SURFACE_WIDTH * SURFACE_HEIGHT];
+fpf_compositor compositor;
+size_t tiles_rendered[MAX_THREADS];
+size_t glyphs_drawn;
+
+double GetSeconds()
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+void* Composite(void* argument)
+{
+    const unsigned int worker_index = (unsigned int)(size_t)argument;
+    tiles_rendered[worker_index] = fpf_composite_tiles(&compositor, worker_index);
+    return NULL;
+}
+
+// Composites the commands with thread_count workers; worker 0 runs on the calling thread.
+// Returns: the total number of tiles rendered (and sets glyphs_drawn).
+size_t CompositeWithThreads(unsigned int thread_count)
+{
+    pthread_t threads[MAX_THREADS];
+    size_t total = 0;
+
+    if (0 != fpf_begin_composite(&compositor, glyph_bits, surface, SURFACE_WIDTH, SURFACE_HEIGHT, SURFACE_WIDTH,
+                                 commands, COMMAND_COUNT, thread_count))
+    {
+        return 0;
+    }
+
+    for (unsigned int i = 1; i < thread_count; ++i)
+    {
+        pthread_create(&threads[i], NULL, Composite, (void*)(size_t)i);
+    }
+    Composite((void*)0);
+    for (unsigned int i = 1; i < thread_count; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    glyphs_drawn = fpf_end_composite(&compositor);
+
+    for (unsigned int i = 0; i < thread_count; ++i)
+    {
+        total += tiles_rendered[i];
+    }
+    return total;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    const size_t tile_count = ((SURFACE_WIDTH + FPF_COMPOSITOR_TILE_SIZE - 1) / FPF_COMPOSITOR_TILE_SIZE) *
+                              ((SURFACE_HEIGHT + FPF_COMPOSITOR_TILE_SIZE - 1) / FPF_COMPOSITOR_TILE_SIZE);
+    double single_thread_seconds = 0.0;
+    size_t single_thread_glyphs = 0;
+    int failed = 0;
+
+    fpf_create_glyph_bits(glyph_bits);
+
+    // Boxes of 1 to 8 lines of up to 30 characters, placed so some cross every edge of the surface.
+    srand(1234);
+    for (unsigned int i = 0; i < COMMAND_COUNT; ++i)
+    {
+        const int line_count = 1 + rand() % 8;
+        size_t length = 0;
+
+        for (int line = 0; line < line_count; ++line)
+        {
+            length += (size_t)snprintf(&texts[i][length], sizeof(texts[i]) - length, "%s#%u line %d: %d%s",
+                                       (0 == line) ? "" : "\n", i, line, rand() % 100000, (0 == rand() % 3) ? " [ok]" : "");
+        }
+
+        commands[i].x = rand() % (SURFACE_WIDTH + 200) - 100;
+        commands[i].y = rand() % (SURFACE_HEIGHT + 60) - 30;
+        commands[i].text = texts[i];
+        commands[i].length = length;
+        commands[i].alpha = (unsigned char)(1 + i % 255);
+    }
+
+    for (unsigned int i = 0; i < COMMAND_COUNT; ++i)
+    {
+        fpf_draw_text_alpha8(glyph_bits, expected_surface, SURFACE_WIDTH, SURFACE_HEIGHT, SURFACE_WIDTH,
+                             commands[i].x, commands[i].y, commands[i].text, commands[i].length, commands[i].alpha);
+    }
+
+    for (unsigned int thread_count = 1; thread_count <= MAX_THREADS; thread_count *= 2)
+    {
+        double seconds;
+
+        memset(surface, 0, sizeof(surface));
+        const size_t tiles = CompositeWithThreads(thread_count);
+        const size_t glyphs = glyphs_drawn;
+        const int matches = (0 == memcmp(surface, expected_surface, sizeof(surface)));
+
+        const double start = GetSeconds();
+        for (int repetition = 0; repetition < REPETITIONS; ++repetition)
+        {
+            CompositeWithThreads(thread_count);
+        }
+        seconds = (GetSeconds() - start) / REPETITIONS;
+        if (1 == thread_count)
+        {
+            single_thread_seconds = seconds;
+            single_thread_glyphs = glyphs;
+        }
+
+        printf("%u thread(s): %zu of %zu tiles, %zu glyphs, %s, %.3f ms per composite (%.2fx)\n", thread_count, tiles,
+               tile_count, glyphs, matches ? "matches" : "DIFFERS", seconds * 1e3, single_thread_seconds / seconds);
+
+        // Every thread count draws the same glyphs (the workers' counts add up to the same total).
+        if (!matches || tiles != tile_count || 0 == glyphs || glyphs != single_thread_glyphs)
+        {
+            failed = 1;
+        }
+    }
+
+    // A composite that needs more bin entries than the compositor holds reports the size and draws nothing.
+    // Each box here is a 200 character line followed by 55 empty ones: about 20 by 6 tiles.
+    for (unsigned int i = 0; i < COMMAND_COUNT; ++i)
+    {
+        memset(texts[i], 'W', 200);
+        memset(&texts[i][200], '\n', 55);
+        commands[i].x = 0;
+        commands[i].y = 0;
+        commands[i].length = 255;
+    }
+    const size_t required = fpf_begin_composite(&compositor, glyph_bits, surface, SURFACE_WIDTH, SURFACE_HEIGHT,
+                                                SURFACE_WIDTH, commands, COMMAND_COUNT, 4);
+    const size_t tiles_after_overflow = fpf_composite_tiles(&compositor, 0);
+    printf("oversized composite needs %zu bin entries (holds %u); rendered %zu tiles\n",
+           required, FPF_COMPOSITOR_MAX_BIN_ENTRIES, tiles_after_overflow);
+    if (required <= FPF_COMPOSITOR_MAX_BIN_ENTRIES || 0 != tiles_after_overflow)
+    {
+        failed = 1;
+    }
+
+    // Too many tiles (7680x4320 is 120x68) or too many commands is refused before anything is binned.
+    const size_t too_many_tiles = fpf_begin_composite(&compositor, glyph_bits, surface, 7680, 4320, 7680, commands,
+                                                      COMMAND_COUNT, 4);
+    const size_t tiles_after_too_many_tiles = fpf_composite_tiles(&compositor, 0);
+    const size_t too_many_commands = fpf_begin_composite(&compositor, glyph_bits, surface, SURFACE_WIDTH,
+                                                         SURFACE_HEIGHT, SURFACE_WIDTH, extra_commands,
+                                                         FPF_COMPOSITOR_MAX_COMMANDS + 1, 4);
+    const size_t tiles_after_too_many_commands = fpf_composite_tiles(&compositor, 0);
+    printf("8K surface %s, %u commands %s\n",
+           (FPF_COMPOSITE_TOO_LARGE == too_many_tiles) ? "refused" : "NOT REFUSED", FPF_COMPOSITOR_MAX_COMMANDS + 1,
+           (FPF_COMPOSITE_TOO_LARGE == too_many_commands) ? "refused" : "NOT REFUSED");
+    if (FPF_COMPOSITE_TOO_LARGE != too_many_tiles || 0 != tiles_after_too_many_tiles ||
+        FPF_COMPOSITE_TOO_LARGE != too_many_commands || 0 != tiles_after_too_many_commands)
+    {
+        failed = 1;
+    }
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
@@ -0,0 +1,103 @@
+// -----------------------------------------------------------------------
+// Example program showing the five-pixel-font performance HUD.
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Feeds the HUD a few hundred made-up frame times, then draws it into an 8-bit surface in
+// software and writes the surface out to the console. It also lays out the same panel as a
+// vertex batch and checks the statistics against a sorted copy of the frame times.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FPF_IMPLEMENTATION
+#include "fpf_perf_hud.h"
+
+const unsigned int surface_width = 128;
+const unsigned int surface_height = 80;
+unsigned char surface[80][128];
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+fpf_vertex vertices[FPF_HUD_MAX_VERTICES];
+fpf_perf_hud hud;
+
+int CompareFloats(const void* a, const void* b)
+{
+    const float left = *(const float*)a;
+    const float right = *(const float*)b;
+    return (left > right) - (left < right);
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    fpf_init_perf_hud(&hud);
+    fpf_hud_counter* p_draws = fpf_register_hud_counter(&hud, "draws");
+    fpf_hud_counter* p_jobs = fpf_register_hud_counter(&hud, "jobs");
+
+    // Mostly 60 Hz frames with a hitch every so often.
+    for (unsigned int frame = 0; frame < 300; ++frame)
+    {
+        fpf_hud_count(p_draws, 100 + frame % 7);
+        fpf_hud_count(p_jobs, 3);
+        const double frame_seconds = (0 == frame % 37) ? 0.031 : 0.0160 + 0.0002 * (frame % 9);
+        fpf_end_hud_frame(&hud, frame_seconds);
+    }
+
+    fpf_create_glyph_bits(glyph_bits);
+    fpf_draw_perf_hud_alpha8(&hud, glyph_bits, &surface[0][0], surface_width, surface_height,
+        surface_width, 1, 1, 0xff);
+
+    for (unsigned int y = 0; y < surface_height; ++y)
+    {
+        for (unsigned int x = 0; x < surface_width; ++x)
+        {
+            putchar(surface[y][x] ? '#' : ' ');
+        }
+        putchar('\n');
+    }
+
+    const size_t vertex_count = fpf_layout_perf_hud(&hud, 1.0f, 1.0f, 0xffffffffu, FPF_VECTOR_Y_AXIS,
+        vertices, FPF_HUD_MAX_VERTICES);
+    printf("vertex batch: %u vertices\n", (unsigned int)vertex_count);
+
+    // Check the statistics.
+    float sorted_ms[FPF_HUD_FRAME_COUNT];
+    for (unsigned int i = 0; i < FPF_HUD_FRAME_COUNT; ++i)
+    {
+        sorted_ms[i] = hud.frame_ms[i];
+    }
+    qsort(sorted_ms, FPF_HUD_FRAME_COUNT, sizeof(float), CompareFloats);
+    const float expected_p99 = sorted_ms[(FPF_HUD_FRAME_COUNT * 99 + 99) / 100 - 1];
+
+    printf("min %f avg %f p99 %f (expected min %f p99 %f)\n",
+        hud.min_ms, hud.avg_ms, hud.p99_ms, sorted_ms[0], expected_p99);
+
+    return (hud.min_ms == sorted_ms[0] && hud.p99_ms == expected_p99 && 0 != vertex_count) ? 0 : 1;
+}
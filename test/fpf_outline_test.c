@@ -0,0 +1,220 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: outline and shadow atlas test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+
+// Creates the outline and drop shadow atlases in both y-axis directions, at their tightest pitch
+// and with padding, and checks every glyph (those in the atlases' edge cells included) against
+// the plain alpha atlas: the red channel is the glyph, the green channel is the glyph dilated by
+// a pixel (outline) or plus itself moved a pixel right and down (shadow), and nothing leaks in
+// from neighboring glyphs or past the end of each row. Then writes an outlined glyph out to the
+// console.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+#define PADDING 6
+
+unsigned char alpha_texture[FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT];
+unsigned char outline_texture[(FPF_OUTLINE_TEXTURE_WIDTH * 2 + PADDING) * FPF_OUTLINE_TEXTURE_HEIGHT];
+unsigned char shadow_texture[(FPF_TEXTURE_WIDTH * 2 + PADDING) * FPF_TEXTURE_HEIGHT];
+
+// Gets a pixel of a glyph from the plain atlas; 0 outside of its 6x6 cell.
+int GlyphPixel(unsigned int glyph_index, int x, int y)
+{
+    const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
+    if (x < 0 || y < 0 || x >= (int)FPF_GLYPH_WIDTH || y >= (int)FPF_GLYPH_HEIGHT)
+    {
+        return 0;
+    }
+    const unsigned int atlas_x = (glyph_index % glyphs_per_row) * FPF_GLYPH_WIDTH + (unsigned int)x;
+    const unsigned int atlas_y = (glyph_index / glyphs_per_row) * FPF_GLYPH_HEIGHT + (unsigned int)y;
+    return 0 != alpha_texture[atlas_y * FPF_TEXTURE_WIDTH + atlas_x];
+}
+
+// Gets the red and green channels of the texel at [x, y] (counted from the top) of an RG8 texture.
+const unsigned char* Texel(const unsigned char* p_texture, unsigned int height, size_t line_pitch,
+    fpf_y_axis_direction y_axis_direction, unsigned int x, unsigned int y)
+{
+    const unsigned int row = (FPF_RASTER_Y_AXIS == y_axis_direction) ? y : height - 1 - y;
+    return &p_texture[row * line_pitch + x * 2];
+}
+
+// Checks one channel value is 0xff when set and 0x00 when not.
+int Matches(unsigned char value, int set)
+{
+    return value == (set ? 0xff : 0x00);
+}
+
+int CheckOutline(fpf_y_axis_direction y_axis_direction, size_t line_pitch)
+{
+    int failed = 0;
+    const size_t size = line_pitch * FPF_OUTLINE_TEXTURE_HEIGHT;
+    const unsigned int cells_per_row = FPF_OUTLINE_TEXTURE_WIDTH / FPF_OUTLINE_GLYPH_WIDTH;
+
+    memset(outline_texture, 0xcc, sizeof(outline_texture));
+    failed |= (0 == fpf_create_outline_texture(outline_texture, size - 1, line_pitch, y_axis_direction));
+    failed |= (0 != fpf_create_outline_texture(outline_texture, size, line_pitch, y_axis_direction));
+
+    for (unsigned int y = 0; y < FPF_OUTLINE_TEXTURE_HEIGHT; ++y)
+    {
+        for (unsigned int x = 0; x < FPF_OUTLINE_TEXTURE_WIDTH; ++x)
+        {
+            const unsigned int glyph_index = (y / FPF_OUTLINE_GLYPH_HEIGHT) * cells_per_row + x / FPF_OUTLINE_GLYPH_WIDTH;
+            const int glyph_x = (int)(x % FPF_OUTLINE_GLYPH_WIDTH) - 1;
+            const int glyph_y = (int)(y % FPF_OUTLINE_GLYPH_HEIGHT) - 1;
+            const unsigned char* const p_texel =
+                Texel(outline_texture, FPF_OUTLINE_TEXTURE_HEIGHT, line_pitch, y_axis_direction, x, y);
+            int glyph = 0;
+            int outline = 0;
+
+            // Cells past the last glyph are empty.
+            if (glyph_index < FPF_GLYPH_COUNT)
+            {
+                glyph = GlyphPixel(glyph_index, glyph_x, glyph_y);
+                for (int j = -1; j <= 1; ++j)
+                {
+                    for (int i = -1; i <= 1; ++i)
+                    {
+                        outline |= GlyphPixel(glyph_index, glyph_x + i, glyph_y + j);
+                    }
+                }
+            }
+
+            failed |= !Matches(p_texel[0], glyph) || !Matches(p_texel[1], outline);
+        }
+
+        // The padding past each row is left alone.
+        for (size_t i = FPF_OUTLINE_TEXTURE_WIDTH * 2; i < line_pitch; ++i)
+        {
+            failed |= (0xcc != outline_texture[y * line_pitch + i]);
+        }
+    }
+
+    // The outline cells are where the position functions say.
+    unsigned int x;
+    unsigned int y;
+    fpf_get_glyph_outline_position('~', &x, &y);
+    failed |= (('~' - ' ') % cells_per_row * FPF_OUTLINE_GLYPH_WIDTH != x) ||
+              (('~' - ' ') / cells_per_row * FPF_OUTLINE_GLYPH_HEIGHT != y);
+    fpf_get_cursor_glyph_outline_position(FPF_VERTICAL_CURSOR, &x, &y);
+    const unsigned int cursor_index = fpf_get_cursor_glyph_index(FPF_VERTICAL_CURSOR);
+    failed |= (cursor_index % cells_per_row * FPF_OUTLINE_GLYPH_WIDTH != x) ||
+              (cursor_index / cells_per_row * FPF_OUTLINE_GLYPH_HEIGHT != y);
+
+    return failed;
+}
+
+int CheckShadow(fpf_y_axis_direction y_axis_direction, size_t line_pitch)
+{
+    int failed = 0;
+    const size_t size = line_pitch * FPF_TEXTURE_HEIGHT;
+    const unsigned int glyphs_per_row = FPF_TEXTURE_WIDTH / FPF_GLYPH_WIDTH;
+
+    memset(shadow_texture, 0xcc, sizeof(shadow_texture));
+    failed |= (0 == fpf_create_shadow_texture(shadow_texture, size - 1, line_pitch, y_axis_direction));
+    failed |= (0 != fpf_create_shadow_texture(shadow_texture, size, line_pitch, y_axis_direction));
+
+    for (unsigned int y = 0; y < FPF_TEXTURE_HEIGHT; ++y)
+    {
+        for (unsigned int x = 0; x < FPF_TEXTURE_WIDTH; ++x)
+        {
+            const unsigned int glyph_index = (y / FPF_GLYPH_HEIGHT) * glyphs_per_row + x / FPF_GLYPH_WIDTH;
+            const int glyph_x = (int)(x % FPF_GLYPH_WIDTH);
+            const int glyph_y = (int)(y % FPF_GLYPH_HEIGHT);
+            const unsigned char* const p_texel =
+                Texel(shadow_texture, FPF_TEXTURE_HEIGHT, line_pitch, y_axis_direction, x, y);
+            int glyph = 0;
+            int shadow = 0;
+
+            // The columns past the last cell of a row and the cells past the last glyph are empty.
+            if (x < glyphs_per_row * FPF_GLYPH_WIDTH && glyph_index < FPF_GLYPH_COUNT)
+            {
+                glyph = GlyphPixel(glyph_index, glyph_x, glyph_y);
+                shadow = glyph | GlyphPixel(glyph_index, glyph_x - 1, glyph_y - 1);
+            }
+
+            failed |= !Matches(p_texel[0], glyph) || !Matches(p_texel[1], shadow);
+        }
+
+        for (size_t i = FPF_TEXTURE_WIDTH * 2; i < line_pitch; ++i)
+        {
+            failed |= (0xcc != shadow_texture[y * line_pitch + i]);
+        }
+    }
+
+    return failed;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    int failed = 0;
+    const fpf_y_axis_direction directions[] = { FPF_RASTER_Y_AXIS, FPF_VECTOR_Y_AXIS };
+    const char* const direction_names[] = { "raster", "vector" };
+
+    fpf_create_alpha_texture(alpha_texture, sizeof(alpha_texture), FPF_TEXTURE_WIDTH, FPF_RASTER_Y_AXIS);
+
+    for (unsigned int j = 0; j < 2; ++j)
+    {
+        for (size_t padding = 0; padding <= PADDING; padding += PADDING)
+        {
+            const int outline_failed = CheckOutline(directions[j], FPF_OUTLINE_TEXTURE_WIDTH * 2 + padding);
+            const int shadow_failed = CheckShadow(directions[j], FPF_TEXTURE_WIDTH * 2 + padding);
+            printf("%s, pitch +%u: outline %s, shadow %s\n", direction_names[j], (unsigned int)padding,
+                outline_failed ? "FAILED" : "ok", shadow_failed ? "FAILED" : "ok");
+            failed |= outline_failed | shadow_failed;
+        }
+    }
+
+    // An outlined glyph: '#' is the glyph, '+' is its outline.
+    unsigned int x;
+    unsigned int y;
+    const size_t line_pitch = FPF_OUTLINE_TEXTURE_WIDTH * 2;
+    fpf_create_outline_texture(outline_texture, sizeof(outline_texture), line_pitch, FPF_RASTER_Y_AXIS);
+    fpf_get_glyph_outline_position('A', &x, &y);
+    for (unsigned int row = 0; row < FPF_OUTLINE_GLYPH_HEIGHT; ++row)
+    {
+        for (unsigned int column = 0; column < FPF_OUTLINE_GLYPH_WIDTH; ++column)
+        {
+            const unsigned char* const p_texel = &outline_texture[(y + row) * line_pitch + (x + column) * 2];
+            putchar(p_texel[0] ? '#' : p_texel[1] ? '+' : '.');
+        }
+        putchar('\n');
+    }
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
@@ -0,0 +1,217 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: shared-memory text overlay test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Forks three producer processes (like a capture daemon, an encoder and a health monitor) that
+// each rewrite their own panel of a shared overlay as fast as they can, while this process
+// reads the overlay like a renderer would. Every copy the consumer accepts has to be
+// self-consistent, and once the producers exit the drawn overlay has to match their last text.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define FPF_IMPLEMENTATION
+#include "fpf_shared_overlay.h"
+
+#define PRODUCER_COUNT  3
+#define UPDATE_COUNT    200000
+#define SURFACE_WIDTH   320
+#define SURFACE_HEIGHT  120
+
+const char* const producer_names[PRODUCER_COUNT] = { "capture", "encoder", "health" };
+fpf_overlay_view view;
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+unsigned char surface[SURFACE_WIDTH * SURFACE_HEIGHT];
+unsigned char expected_surface[SURFACE_WIDTH * SURFACE_HEIGHT];
+fpf_vertex vertices[FPF_OVERLAY_MAX_PANELS * FPF_OVERLAY_PANEL_CHARS * FPF_VERTICES_PER_GLYPH];
+
+// Every update carries its number twice (once scrambled) and in its alpha, so a torn copy shows.
+void FormatUpdate(char* text, size_t size, int producer, unsigned int update)
+{
+    snprintf(text, size, "%s update %07u\nchecksum %07u", producer_names[producer], update,
+             (update * 7919u) % 10000000u);
+}
+
+int Produce(const char* name, int producer)
+{
+    char text[64];
+    fpf_shared_overlay* p_overlay = fpf_open_shared_overlay(name);
+    if (NULL == p_overlay)
+    {
+        return 1;
+    }
+
+    const int panel = fpf_claim_overlay_panel(p_overlay);
+    if (panel < 0)
+    {
+        return 1;
+    }
+
+    for (unsigned int update = 0; update < UPDATE_COUNT; ++update)
+    {
+        FormatUpdate(text, sizeof(text), producer, update);
+        fpf_write_overlay_panel(p_overlay, panel, 4, 4 + producer * 3 * (int)FPF_GLYPH_HEIGHT, 0xffffffffu,
+                                (unsigned char)(1 + update % 255), text);
+    }
+
+    fpf_close_shared_overlay(p_overlay);
+    return 0;
+}
+
+// Returns: the producer that wrote a panel copy, or -1 if the copy isn't self-consistent.
+int CheckPanel(const fpf_overlay_panel_text* p_panel, unsigned int* p_update)
+{
+    char text[FPF_OVERLAY_PANEL_CHARS + 1];
+    char expected[64];
+    char name[16];
+
+    memcpy(text, p_panel->text, p_panel->length);
+    text[p_panel->length] = '\0';
+    if (2 != sscanf(text, "%15s update %u", name, p_update))
+    {
+        return -1;
+    }
+
+    for (int producer = 0; producer < PRODUCER_COUNT; ++producer)
+    {
+        FormatUpdate(expected, sizeof(expected), producer, *p_update);
+        if (0 == strcmp(text, expected) && p_panel->alpha == 1 + *p_update % 255 &&
+            p_panel->y == 4 + producer * 3 * (int)FPF_GLYPH_HEIGHT)
+        {
+            return producer;
+        }
+    }
+    return -1;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    char name[64];
+    pid_t producers[PRODUCER_COUNT];
+    size_t frames = 0;
+    size_t changed_panels = 0;
+    int running = PRODUCER_COUNT;
+    int failed = 0;
+
+    snprintf(name, sizeof(name), "/fpf_overlay_test.%d", (int)getpid());
+    fpf_shared_overlay* p_overlay = fpf_create_shared_overlay(name);
+    if (NULL == p_overlay)
+    {
+        printf("couldn't create shared memory object %s\nFAILED\n", name);
+        return 1;
+    }
+    fpf_init_overlay_view(&view);
+
+    for (int i = 0; i < PRODUCER_COUNT; ++i)
+    {
+        producers[i] = fork();
+        if (0 == producers[i])
+        {
+            _exit(Produce(name, i));
+        }
+    }
+
+    // Render "frames" until every producer has finished, checking each new copy of a panel.
+    while (0 < running)
+    {
+        int status;
+
+        changed_panels += fpf_update_overlay_view(p_overlay, &view);
+        ++frames;
+
+        for (int panel = 0; panel < PRODUCER_COUNT; ++panel)
+        {
+            unsigned int update;
+            if (0 != view.panels[panel].length && CheckPanel(&view.panels[panel], &update) < 0)
+            {
+                failed = 1;
+            }
+        }
+
+        while (0 < waitpid(-1, &status, WNOHANG))
+        {
+            --running;
+            if (!WIFEXITED(status) || 0 != WEXITSTATUS(status))
+            {
+                failed = 1;
+            }
+        }
+    }
+
+    // With the producers gone, one more update has to show each one's last text.
+    changed_panels += fpf_update_overlay_view(p_overlay, &view);
+    printf("%zu frames, %zu panel changes picked up, %zu torn reads retried\n", frames, changed_panels, view.torn_count);
+
+    fpf_create_glyph_bits(glyph_bits);
+    for (int panel = 0; panel < PRODUCER_COUNT; ++panel)
+    {
+        char expected[64];
+        unsigned int update = 0;
+        const int producer = CheckPanel(&view.panels[panel], &update);
+
+        printf("panel %d: %s update %u\n", panel, (producer < 0) ? "bad" : producer_names[producer], update);
+        if (producer < 0 || UPDATE_COUNT - 1 != update)
+        {
+            failed = 1;
+            continue;
+        }
+
+        FormatUpdate(expected, sizeof(expected), producer, update);
+        fpf_draw_text_alpha8(glyph_bits, expected_surface, SURFACE_WIDTH, SURFACE_HEIGHT, SURFACE_WIDTH, 4,
+                             4 + producer * 3 * (int)FPF_GLYPH_HEIGHT, expected, strlen(expected),
+                             (unsigned char)(1 + update % 255));
+    }
+
+    const size_t glyph_count = fpf_draw_overlay_view_alpha8(&view, glyph_bits, surface, SURFACE_WIDTH, SURFACE_HEIGHT,
+                                                            SURFACE_WIDTH);
+    const size_t vertex_count = fpf_layout_overlay_view(&view, FPF_RASTER_Y_AXIS, vertices,
+                                                        sizeof(vertices) / sizeof(vertices[0]));
+    printf("drew %zu glyphs, laid out %zu vertices\n", glyph_count, vertex_count);
+    if (0 != memcmp(surface, expected_surface, sizeof(surface)) || glyph_count * FPF_VERTICES_PER_GLYPH != vertex_count)
+    {
+        failed = 1;
+    }
+
+    // Once removed, the overlay can no longer be opened.
+    fpf_close_shared_overlay(p_overlay);
+    fpf_remove_shared_overlay(name);
+    if (NULL != fpf_open_shared_overlay(name))
+    {
+        failed = 1;
+    }
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
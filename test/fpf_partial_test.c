@@ -0,0 +1,109 @@
+// -----------------------------------------------------------------------
+// Example program showing partial and packed five-pixel-font texture atlases.
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// A clock only needs digits and a colon. This creates a partial atlas (usual layout, only those
+// cells written) and a packed atlas (only those glyphs, in a small texture), checks every glyph
+// against the full atlas, and writes the packed atlas out to the console.
+
+#include <stdio.h>
+#include <string.h>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+const char characters[] = "0123456789:";
+
+unsigned char full_texture[FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT];
+unsigned char partial_texture[FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT];
+unsigned char packed_texture[FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT];
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    int failed = 0;
+
+    fpf_create_alpha_texture(full_texture, sizeof(full_texture), FPF_TEXTURE_WIDTH, FPF_RASTER_Y_AXIS);
+
+    memset(partial_texture, 0xcc, sizeof(partial_texture));
+    failed |= (0 != fpf_create_partial_alpha_texture(partial_texture, sizeof(partial_texture), FPF_TEXTURE_WIDTH,
+        FPF_RASTER_Y_AXIS, characters, sizeof(characters) - 1));
+
+    fpf_packed_atlas atlas;
+    fpf_plan_packed_atlas(&atlas, characters, sizeof(characters) - 1);
+    failed |= (0 != fpf_create_packed_alpha_texture(&atlas, packed_texture, sizeof(packed_texture), atlas.width,
+        FPF_RASTER_Y_AXIS));
+
+    // Every wanted glyph (and the fallback glyph) matches the full atlas in both.
+    unsigned int texels_written = 0;
+    for (unsigned int i = 0; i < sizeof(characters); ++i)
+    {
+        const char character = (sizeof(characters) - 1 == i) ? 'Z' : characters[i]; // 'Z' falls back.
+        unsigned int x, y, packed_x, packed_y;
+        fpf_get_glyph_position((sizeof(characters) - 1 == i) ? '\x7f' : character, &x, &y);
+        fpf_get_packed_glyph_position(&atlas, character, &packed_x, &packed_y);
+
+        for (unsigned int k = 0; k < FPF_GLYPH_HEIGHT; ++k)
+        {
+            for (unsigned int j = 0; j < FPF_GLYPH_WIDTH; ++j)
+            {
+                const unsigned char expected = full_texture[(y + k) * FPF_TEXTURE_WIDTH + x + j];
+                failed |= (expected != partial_texture[(y + k) * FPF_TEXTURE_WIDTH + x + j]);
+                failed |= (expected != packed_texture[(packed_y + k) * atlas.width + packed_x + j]);
+            }
+        }
+    }
+
+    // Nothing else in the partial atlas was touched.
+    for (unsigned int i = 0; i < sizeof(partial_texture); ++i)
+    {
+        texels_written += (0xcc != partial_texture[i]);
+    }
+    failed |= (texels_written != atlas.glyph_count * FPF_GLYPH_WIDTH * FPF_GLYPH_HEIGHT);
+
+    printf("packed %u glyphs into %ux%u texels (%u bytes instead of %u)\n",
+        atlas.glyph_count, atlas.width, atlas.height, atlas.width * atlas.height,
+        FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT);
+
+    for (unsigned int y = 0; y < atlas.height; ++y)
+    {
+        putchar('[');
+        for (unsigned int x = 0; x < atlas.width; ++x)
+        {
+            putchar(packed_texture[y * atlas.width + x] ? '#' : ' ');
+        }
+        putchar(']');
+        putchar('\n');
+    }
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
@@ -0,0 +1,149 @@
+// -----------------------------------------------------------------------
+// Stress test of the five-pixel-font lock-free debug text queue.
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Several worker threads push text as fast as they can while the main thread drains the queue,
+// like a render thread would. Every push has to be either drawn or counted as dropped. Then a
+// record too long for the vertex buffer has to be cut to fit, not block the records behind it, and
+// a buffer too small for one glyph must leave the records queued.
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#define FPF_IMPLEMENTATION
+#include "fpf_text_queue.h"
+
+#define PRODUCER_COUNT 4
+#define PUSHES_PER_PRODUCER 200000
+
+fpf_text_queue queue;
+fpf_vertex vertices[FPF_TEXT_QUEUE_CAPACITY * FPF_TEXT_RECORD_CHARS * FPF_VERTICES_PER_GLYPH];
+int producers_done = 0;
+pthread_mutex_t done_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void* Produce(void* argument)
+{
+    const int producer = (int)(size_t)argument;
+    char text[32];
+    size_t queued = 0;
+
+    for (int i = 0; i < PUSHES_PER_PRODUCER; ++i)
+    {
+        // Every record is exactly 10 glyphs, so the drain can be checked.
+        snprintf(text, sizeof(text), "P%d:%07d", producer, i);
+        queued += fpf_push_text(&queue, 0.0f, (float)(producer * FPF_GLYPH_HEIGHT), 0xffffffffu, text);
+    }
+
+    pthread_mutex_lock(&done_mutex);
+    ++producers_done;
+    pthread_mutex_unlock(&done_mutex);
+
+    return (void*)queued;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    pthread_t threads[PRODUCER_COUNT];
+    size_t drawn_records = 0;
+    size_t dropped_records = 0;
+    size_t queued_records = 0;
+    int failed = 0;
+
+    fpf_init_text_queue(&queue);
+
+    for (int i = 0; i < PRODUCER_COUNT; ++i)
+    {
+        pthread_create(&threads[i], NULL, Produce, (void*)(size_t)i);
+    }
+
+    for (;;)
+    {
+        pthread_mutex_lock(&done_mutex);
+        const int done = (PRODUCER_COUNT == producers_done);
+        pthread_mutex_unlock(&done_mutex);
+
+        const size_t vertex_count = fpf_drain_text_queue(
+            &queue, FPF_RASTER_Y_AXIS, vertices, sizeof(vertices) / sizeof(vertices[0]));
+        if (0 != vertex_count % (10 * FPF_VERTICES_PER_GLYPH))
+        {
+            failed = 1;
+        }
+        drawn_records += vertex_count / (10 * FPF_VERTICES_PER_GLYPH);
+        dropped_records += fpf_take_text_queue_dropped_count(&queue);
+
+        if (done && 0 == vertex_count)
+        {
+            break;
+        }
+    }
+
+    for (int i = 0; i < PRODUCER_COUNT; ++i)
+    {
+        void* queued;
+        pthread_join(threads[i], &queued);
+        queued_records += (size_t)queued;
+    }
+    dropped_records += fpf_take_text_queue_dropped_count(&queue);
+
+    printf("pushed %d, drawn %zu, dropped %zu\n",
+        PRODUCER_COUNT * PUSHES_PER_PRODUCER, drawn_records, dropped_records);
+
+    if (drawn_records != queued_records || drawn_records + dropped_records != PRODUCER_COUNT * PUSHES_PER_PRODUCER)
+    {
+        failed = 1;
+    }
+
+    // A full-length record drained into a 100 vertex (16 glyph) buffer, then a 10 glyph record. A
+    // buffer without room for one glyph drains nothing first.
+    char long_text[FPF_TEXT_RECORD_CHARS + 1];
+    memset(long_text, 'L', FPF_TEXT_RECORD_CHARS);
+    long_text[FPF_TEXT_RECORD_CHARS] = '\0';
+    fpf_init_text_queue(&queue);
+    fpf_push_text(&queue, 0.0f, 0.0f, 0xffffffffu, long_text);
+    fpf_push_text(&queue, 0.0f, 0.0f, 0xffffffffu, "P0:0000000");
+    const size_t tiny_count = fpf_drain_text_queue(&queue, FPF_RASTER_Y_AXIS, NULL, 0) +
+                              fpf_drain_text_queue(&queue, FPF_RASTER_Y_AXIS, vertices, FPF_VERTICES_PER_GLYPH - 1);
+    const size_t cut_count = fpf_drain_text_queue(&queue, FPF_RASTER_Y_AXIS, vertices, 100);
+    const size_t next_count = fpf_drain_text_queue(&queue, FPF_RASTER_Y_AXIS, vertices, 100);
+    const size_t empty_count = fpf_drain_text_queue(&queue, FPF_RASTER_Y_AXIS, vertices, 100);
+    printf("long record: %zu vertices, then %zu, then %zu (%zu with no room)\n", cut_count, next_count, empty_count,
+        tiny_count);
+
+    if (0 != tiny_count || 16 * FPF_VERTICES_PER_GLYPH != cut_count || 10 * FPF_VERTICES_PER_GLYPH != next_count || 0 != empty_count)
+    {
+        failed = 1;
+    }
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
@@ -0,0 +1,107 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: scaled drawing test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Draws text at every integer scale into 8-bit and 32-bit surfaces, including text hanging off
+// every edge, and checks it against text drawn at 1x and blown up pixel by pixel.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+#define SMALL_WIDTH     61
+#define SMALL_HEIGHT    23
+
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+unsigned char small_surface[SMALL_HEIGHT * SMALL_WIDTH];
+unsigned char alpha_surface[SMALL_HEIGHT * FPF_MAX_SCALE][SMALL_WIDTH * FPF_MAX_SCALE];
+unsigned int color_surface[SMALL_HEIGHT * FPF_MAX_SCALE][SMALL_WIDTH * FPF_MAX_SCALE];
+
+const char text[] = "Scaled TEXT\n~@#$%^&*()_+{}|:\"<>?\nlast line: 0123456789";
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    int failed = 0;
+    fpf_create_glyph_bits(glyph_bits);
+
+    const int positions[][2] = { { 2, 1 }, { -4, -3 }, { 40, 15 }, { -20, 10 } };
+    for (unsigned int scale = 1; scale <= FPF_MAX_SCALE; ++scale)
+    {
+        const unsigned int width = SMALL_WIDTH * scale;
+        const unsigned int height = SMALL_HEIGHT * scale;
+        int scale_failed = 0;
+
+        for (unsigned int p = 0; p < sizeof(positions) / sizeof(positions[0]); ++p)
+        {
+            memset(small_surface, 0, sizeof(small_surface));
+            memset(alpha_surface, 0x11, sizeof(alpha_surface));
+            for (unsigned int row = 0; row < SMALL_HEIGHT * FPF_MAX_SCALE; ++row)
+            {
+                for (unsigned int column = 0; column < SMALL_WIDTH * FPF_MAX_SCALE; ++column)
+                {
+                    color_surface[row][column] = 0x11111111u;
+                }
+            }
+
+            const int x = positions[p][0];
+            const int y = positions[p][1];
+            const size_t small_count = fpf_draw_text_alpha8(glyph_bits, small_surface, SMALL_WIDTH, SMALL_HEIGHT,
+                SMALL_WIDTH, x, y, text, sizeof(text) - 1, 0xff);
+            const size_t alpha_count = fpf_draw_text_alpha8_scaled(glyph_bits, &alpha_surface[0][0], width, height,
+                sizeof(alpha_surface[0]), x * (int)scale, y * (int)scale, text, sizeof(text) - 1, 0xff, scale);
+            const size_t color_count = fpf_draw_text_rgba32_scaled(glyph_bits, &color_surface[0][0], width, height,
+                sizeof(color_surface[0]), x * (int)scale, y * (int)scale, text, sizeof(text) - 1, 0xff00ff00u, scale);
+            scale_failed |= (small_count != alpha_count) || (small_count != color_count);
+
+            // Inside the surface, every pixel is its 1x pixel blown up; outside, nothing changed.
+            for (unsigned int row = 0; row < SMALL_HEIGHT * FPF_MAX_SCALE; ++row)
+            {
+                for (unsigned int column = 0; column < SMALL_WIDTH * FPF_MAX_SCALE; ++column)
+                {
+                    const int inside = (row < height && column < width);
+                    const int set = inside && small_surface[(row / scale) * SMALL_WIDTH + column / scale];
+                    scale_failed |= (alpha_surface[row][column] != (set ? 0xff : 0x11));
+                    scale_failed |= (color_surface[row][column] != (set ? 0xff00ff00u : 0x11111111u));
+                }
+            }
+        }
+
+        printf("x%u %s\n", scale, scale_failed ? "FAILED" : "ok");
+        failed |= scale_failed;
+    }
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
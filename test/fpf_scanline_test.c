@@ -0,0 +1,103 @@
+// -----------------------------------------------------------------------
+// Example program showing the five-pixel-font scanline renderer.
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Renders a row of text one scanline at a time, the way a display controller with a line buffer
+// would take it, and writes the 1bpp lines out to the console. The 8bpp and 16bpp lines are
+// checked against fpf_draw_text_alpha8(), and the seek index against decompressing in order.
+
+#include <stdio.h>
+#include <string.h>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+const char text[] = "Beam 12:34 {ok} \x7f~";
+const size_t length = sizeof(text) - 1;
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    int failed = 0;
+
+    // Seeking to any row must match decompressing every row before it.
+    fpf_font_decoder sequential;
+    fpf_init_font_decoder(&sequential);
+    for (unsigned int row = 0; row < FPF_TEXTURE_HEIGHT; ++row)
+    {
+        fpf_font_decoder seeking;
+        unsigned char expected[FPF_ROW_BITS_SIZE];
+        unsigned char actual[FPF_ROW_BITS_SIZE];
+        fpf_seek_font_decoder(&seeking, row);
+        fpf_decode_row_bits(&sequential, expected);
+        fpf_decode_row_bits(&seeking, actual);
+        failed |= (0 != memcmp(expected, actual, FPF_ROW_BITS_SIZE));
+    }
+
+    // The whole row of text, drawn the usual way for reference.
+    unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+    unsigned char reference[FPF_GLYPH_HEIGHT][sizeof(text) * FPF_GLYPH_WIDTH];
+    const size_t width = length * FPF_GLYPH_WIDTH;
+    memset(reference, 0, sizeof(reference));
+    fpf_create_glyph_bits(glyph_bits);
+    fpf_draw_text_alpha8(glyph_bits, &reference[0][0], (unsigned int)width, FPF_GLYPH_HEIGHT,
+        sizeof(reference[0]), 0, 0, text, length, 0xff);
+
+    // The scanline renderer only ever needs one line.
+    unsigned char line_1bpp[(sizeof(text) * FPF_GLYPH_WIDTH + 7) / 8];
+    unsigned char line_8bpp[sizeof(text) * FPF_GLYPH_WIDTH];
+    unsigned short line_16bpp[sizeof(text) * FPF_GLYPH_WIDTH];
+
+    for (unsigned int scanline = 0; scanline < FPF_GLYPH_HEIGHT; ++scanline)
+    {
+        failed |= (0 != fpf_render_text_scanline(text, length, scanline, FPF_1BPP, 1, 0, line_1bpp, sizeof(line_1bpp)));
+        failed |= (0 != fpf_render_text_scanline(text, length, scanline, FPF_8BPP, 0xff, 0x00, line_8bpp, sizeof(line_8bpp)));
+        failed |= (0 != fpf_render_text_scanline(text, length, scanline, FPF_16BPP, 0xf800, 0x001f, line_16bpp, sizeof(line_16bpp)));
+
+        for (size_t x = 0; x < width; ++x)
+        {
+            const int on = (0 != reference[scanline][x]);
+            const int bit = (0 != (line_1bpp[x / 8] & (0x80 >> (x % 8))));
+            failed |= (on != bit);
+            failed |= (line_8bpp[x] != (on ? 0xff : 0x00));
+            failed |= (line_16bpp[x] != (on ? 0xf800 : 0x001f));
+            putchar(bit ? '#' : ' ');
+        }
+        putchar('\n');
+    }
+
+    // Too small a line reports the size it needs.
+    failed |= (sizeof(line_8bpp) - FPF_GLYPH_WIDTH !=
+        fpf_render_text_scanline(text, length, 0, FPF_8BPP, 0xff, 0x00, line_8bpp, 10));
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
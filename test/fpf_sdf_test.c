@@ -0,0 +1,185 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: distance field test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Creates distance field atlases with a few spreads and checks them against the bitmap font:
+// every texel is on the right side of the edge, and the field blown up 12x with bilinear
+// filtering (like a GPU would) comes back as the same pixel art. Bilinear filtering can only nick
+// a corner, so the only differences allowed are within a texel of a corner. Then writes a few
+// magnified glyphs out to the console.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+#define MAGNIFICATION 12
+
+unsigned char alpha_texture[FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT];
+unsigned char sdf_texture[FPF_SDF_TEXTURE_WIDTH(FPF_SDF_MAX_SPREAD) * FPF_SDF_TEXTURE_HEIGHT(FPF_SDF_MAX_SPREAD)];
+
+// Samples the field with bilinear filtering at [u, v] (DirectX style texture coordinates).
+float Sample(const unsigned char* p_texture, const unsigned int width, const unsigned int height, float u, float v)
+{
+    const float x = u * width - 0.5f;
+    const float y = v * height - 0.5f;
+    const int x0 = (int)(x + 1.0f) - 1;
+    const int y0 = (int)(y + 1.0f) - 1;
+    const float fx = x - x0;
+    const float fy = y - y0;
+    float texels[2][2];
+    for (int j = 0; j < 2; ++j)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            const int tx = (x0 + i < 0) ? 0 : (x0 + i >= (int)width) ? (int)width - 1 : x0 + i;
+            const int ty = (y0 + j < 0) ? 0 : (y0 + j >= (int)height) ? (int)height - 1 : y0 + j;
+            texels[j][i] = p_texture[ty * width + tx];
+        }
+    }
+    return (texels[0][0] * (1 - fx) + texels[0][1] * fx) * (1 - fy) + (texels[1][0] * (1 - fx) + texels[1][1] * fx) * fy;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    int failed = 0;
+    const unsigned int spreads[] = { 2, 4, 8 };
+
+    fpf_create_alpha_texture(alpha_texture, sizeof(alpha_texture), FPF_TEXTURE_WIDTH, FPF_RASTER_Y_AXIS);
+    failed |= (0 == fpf_create_sdf_texture(sdf_texture, 16, FPF_SDF_TEXTURE_WIDTH(4), FPF_RASTER_Y_AXIS, 4));
+
+    for (unsigned int s = 0; s < sizeof(spreads) / sizeof(spreads[0]); ++s)
+    {
+        const unsigned int spread = spreads[s];
+        const unsigned int width = FPF_SDF_TEXTURE_WIDTH(spread);
+        const unsigned int height = FPF_SDF_TEXTURE_HEIGHT(spread);
+        unsigned int texel_mismatches = 0;
+        unsigned int magnified_mismatches = 0;
+        unsigned int corner_mismatches = 0;
+        unsigned int magnified_pixels = 0;
+
+        failed |= (0 != fpf_create_sdf_texture(sdf_texture, sizeof(sdf_texture), width, FPF_RASTER_Y_AXIS, spread));
+
+        for (unsigned int glyph = 0; glyph < FPF_GLYPH_COUNT; ++glyph)
+        {
+            const char character = (glyph < 96) ? (char)(' ' + glyph) : '\0';
+            unsigned int x, y, sdf_x, sdf_y;
+            float left, top, right, bottom;
+            if (glyph < 96)
+            {
+                fpf_get_glyph_position(character, &x, &y);
+                fpf_get_glyph_sdf_position(character, spread, &sdf_x, &sdf_y);
+                fpf_get_glyph_sdf_dx_texture_coordinates(character, spread, &left, &top, &right, &bottom);
+            }
+            else
+            {
+                fpf_get_cursor_glyph_position((fpf_cursor_style)(glyph - 96), &x, &y);
+                fpf_get_cursor_glyph_sdf_position((fpf_cursor_style)(glyph - 96), spread, &sdf_x, &sdf_y);
+                fpf_get_cursor_glyph_sdf_dx_texture_coordinates((fpf_cursor_style)(glyph - 96), spread, &left, &top, &right, &bottom);
+            }
+
+            // Texel centers are on the right side of the edge.
+            for (unsigned int j = 0; j < FPF_GLYPH_HEIGHT * FPF_SDF_TEXELS_PER_PIXEL; ++j)
+            {
+                for (unsigned int i = 0; i < FPF_GLYPH_WIDTH * FPF_SDF_TEXELS_PER_PIXEL; ++i)
+                {
+                    const int set = 0 != alpha_texture[(y + j / FPF_SDF_TEXELS_PER_PIXEL) * FPF_TEXTURE_WIDTH + x + i / FPF_SDF_TEXELS_PER_PIXEL];
+                    texel_mismatches += (set != (sdf_texture[(sdf_y + j) * width + sdf_x + i] > 127));
+                }
+            }
+
+            // The magnified glyph (plus a pixel all around) matches the pixel art.
+            const int size = (int)(FPF_GLYPH_WIDTH * MAGNIFICATION);
+            for (int j = -MAGNIFICATION; j < size + MAGNIFICATION; ++j)
+            {
+                for (int i = -MAGNIFICATION; i < size + MAGNIFICATION; ++i)
+                {
+                    const float u = left + (right - left) * (i + 0.5f) / size;
+                    const float v = top + (bottom - top) * (j + 0.5f) / size;
+                    const int pixel_x = (i < 0) ? -1 : i / MAGNIFICATION;
+                    const int pixel_y = (j < 0) ? -1 : j / MAGNIFICATION;
+                    const int set = pixel_x >= 0 && pixel_y >= 0 && pixel_x < (int)FPF_GLYPH_WIDTH && pixel_y < (int)FPF_GLYPH_HEIGHT &&
+                        0 != alpha_texture[(y + pixel_y) * FPF_TEXTURE_WIDTH + x + pixel_x];
+                    if (set != (Sample(sdf_texture, width, height, u, v) > 127.5f))
+                    {
+                        // Distance (in font pixels) to the nearest pixel corner.
+                        const float fx = (i + 0.5f) / MAGNIFICATION;
+                        const float fy = (j + 0.5f) / MAGNIFICATION;
+                        const float dx = fx - (float)(int)(fx + 100.5f) + 100.0f;
+                        const float dy = fy - (float)(int)(fy + 100.5f) + 100.0f;
+                        const float texel = 1.0f / FPF_SDF_TEXELS_PER_PIXEL;
+                        if (dx > -texel && dx < texel && dy > -texel && dy < texel)
+                        {
+                            ++corner_mismatches;
+                        }
+                        else
+                        {
+                            ++magnified_mismatches;
+                        }
+                    }
+                    ++magnified_pixels;
+                }
+            }
+        }
+
+        printf("spread %u: %ux%u texels, %u texel mismatches, %u of %u magnified pixels differ (%u more nicked off corners)\n",
+            spread, width, height, texel_mismatches, magnified_mismatches, magnified_pixels, corner_mismatches);
+        failed |= (0 != texel_mismatches) || (0 != magnified_mismatches);
+    }
+
+    // Draw a few glyphs at 6x (every other pixel at 12x).
+    const char sample[] = "Sd@";
+    const unsigned int spread = 4;
+    const unsigned int width = FPF_SDF_TEXTURE_WIDTH(spread);
+    const unsigned int height = FPF_SDF_TEXTURE_HEIGHT(spread);
+    fpf_create_sdf_texture(sdf_texture, sizeof(sdf_texture), width, FPF_RASTER_Y_AXIS, spread);
+    for (int j = 0; j < (int)(FPF_GLYPH_HEIGHT * MAGNIFICATION); j += 2)
+    {
+        for (unsigned int k = 0; k < sizeof(sample) - 1; ++k)
+        {
+            float left, top, right, bottom;
+            fpf_get_glyph_sdf_dx_texture_coordinates(sample[k], spread, &left, &top, &right, &bottom);
+            for (int i = 0; i < (int)(FPF_GLYPH_WIDTH * MAGNIFICATION); i += 2)
+            {
+                const float u = left + (right - left) * (i + 0.5f) / (FPF_GLYPH_WIDTH * MAGNIFICATION);
+                const float v = top + (bottom - top) * (j + 0.5f) / (FPF_GLYPH_HEIGHT * MAGNIFICATION);
+                putchar((Sample(sdf_texture, width, height, u, v) > 127.5f) ? '#' : ' ');
+            }
+        }
+        putchar('\n');
+    }
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
@@ -0,0 +1,129 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: compile-time static text test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Renders a few labels at compile time (8-bit and 1bpp) and checks them, and their blits
+// (including ones hanging off every edge of the surface), against fpf_draw_text_alpha8(). It
+// also times a blit against drawing the same text. Build as C++20 or later.
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+#include "fpf_static_text.hpp"
+
+constexpr auto& build_label = fpf::static_text<"build 1234 (release)">;
+constexpr auto& menu_label = fpf::static_text<"File\n\tOpen...\n\tQuit\x01", fpf::sprite_format::bits1>;
+
+// Computed by the compiler: the sizes, and a pixel of the 'b' in "build".
+static_assert(20 * FPF_GLYPH_WIDTH == build_label.width && FPF_GLYPH_HEIGHT == build_label.height);
+static_assert(8 * FPF_GLYPH_WIDTH == menu_label.width && 3 * FPF_GLYPH_HEIGHT == menu_label.height);
+static_assert(6 == menu_label.line_pitch);
+static_assert(0xff == build_label.pixels[1 * build_label.line_pitch + 0]);
+
+const unsigned int surface_width = 100;
+const unsigned int surface_height = 40;
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+unsigned char surface[40][100];
+unsigned char expected[40][100];
+
+double GetSeconds()
+{
+    timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+// Checks a sprite, blitted onto a clear surface at [x, y], against the same text drawn there.
+template <class Sprite>
+bool CheckBlit(const Sprite& sprite, const char* text, int x, int y)
+{
+    std::memset(surface, 0, sizeof(surface));
+    std::memset(expected, 0, sizeof(expected));
+    fpf_draw_text_alpha8(glyph_bits, &expected[0][0], surface_width, surface_height, surface_width, x, y, text,
+                         std::strlen(text), 0xff);
+    fpf::blit(sprite, &surface[0][0], surface_width, surface_height, surface_width, x, y);
+
+    const bool matches = (0 == std::memcmp(surface, expected, sizeof(surface)));
+    std::printf("%-28s at [%4d, %3d]: %s\n", text[0] == 'b' ? "build label" : "menu label", x, y,
+                matches ? "matches" : "DIFFERS");
+    return matches;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    const char build_text[] = "build 1234 (release)";
+    const char menu_text[] = "File\n\tOpen...\n\tQuit\x01";
+    const int positions[][2] = { { 3, 5 }, { -7, -2 }, { 90, 37 }, { -200, 0 }, { 0, 40 }, { 50, -17 } };
+    int failed = 0;
+
+    fpf_create_glyph_bits(glyph_bits);
+
+    // The sprite itself is the text drawn at [0, 0] on its own little surface.
+    unsigned char drawn[build_label.height][build_label.width] = {};
+    fpf_draw_text_alpha8(glyph_bits, &drawn[0][0], build_label.width, build_label.height, build_label.width, 0, 0,
+                         build_text, sizeof(build_text) - 1, 0xff);
+    if (0 != std::memcmp(drawn, build_label.pixels.data(), sizeof(drawn)))
+    {
+        std::printf("build label DIFFERS from fpf_draw_text_alpha8()\n");
+        failed = 1;
+    }
+
+    for (const auto& position : positions)
+    {
+        failed |= !CheckBlit(build_label, build_text, position[0], position[1]);
+        failed |= !CheckBlit(menu_label, menu_text, position[0], position[1]);
+    }
+
+    // Time a blit against drawing the same text (layout and glyph lookup included).
+    const int repetitions = 200000;
+    double start = GetSeconds();
+    for (int i = 0; i < repetitions; ++i)
+    {
+        fpf::blit(build_label, &surface[0][0], surface_width, surface_height, surface_width, i & 7, 3);
+    }
+    const double blit_seconds = GetSeconds() - start;
+    start = GetSeconds();
+    for (int i = 0; i < repetitions; ++i)
+    {
+        fpf_draw_text_alpha8(glyph_bits, &surface[0][0], surface_width, surface_height, surface_width, i & 7, 3,
+                             build_text, sizeof(build_text) - 1, 0xff);
+    }
+    const double draw_seconds = GetSeconds() - start;
+    std::printf("blit %.1f ns, fpf_draw_text_alpha8() %.1f ns per label\n", blit_seconds * 1e9 / repetitions,
+                draw_seconds * 1e9 / repetitions);
+
+    std::printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
@@ -0,0 +1,133 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: statistics test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+
+// Built with FPF_STATS (see the Makefile), so every counter the library keeps is compiled. Makes
+// a few calls with known costs and checks the counters after each, then that a reset clears them.
+// A composite with several worker threads is counted once, when it's finished (run it under
+// ThreadSanitizer to see the workers leave the counters alone).
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifndef FPF_STATS
+#define FPF_STATS
+#endif
+#define FPF_IMPLEMENTATION
+#include "fpf_compositor.h"
+
+#define WORKER_COUNT 4
+
+unsigned char alpha_texture[FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT];
+unsigned char rg_texture[FPF_OUTLINE_TEXTURE_WIDTH * 2 * FPF_OUTLINE_TEXTURE_HEIGHT];
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+unsigned char surface[FPF_GLYPH_HEIGHT * 2][FPF_GLYPH_WIDTH * 16];
+fpf_vertex vertices[16 * FPF_VERTICES_PER_GLYPH];
+unsigned char composite_surface[256][256];
+fpf_compositor compositor;
+
+void* Composite(void* argument)
+{
+    fpf_composite_tiles(&compositor, (unsigned int)(size_t)argument);
+    return NULL;
+}
+
+// Prints the counters and checks them against the expected values.
+int Check(const char* step, size_t glyphs_emitted, size_t fallback_glyphs, size_t texture_bytes_written,
+    size_t layout_calls)
+{
+    fpf_stats stats;
+    fpf_get_stats(&stats);
+
+    const int failed = (glyphs_emitted != stats.glyphs_emitted) || (fallback_glyphs != stats.fallback_glyphs) ||
+                       (texture_bytes_written != stats.texture_bytes_written) || (layout_calls != stats.layout_calls);
+    printf("%-16s glyphs %3zu, fallbacks %zu, texture bytes %6zu, layouts %zu: %s\n", step, stats.glyphs_emitted,
+        stats.fallback_glyphs, stats.texture_bytes_written, stats.layout_calls, failed ? "FAILED" : "ok");
+    return failed;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    const size_t atlas_bytes = FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT;
+    const size_t outline_bytes = FPF_OUTLINE_TEXTURE_WIDTH * 2 * FPF_OUTLINE_TEXTURE_HEIGHT;
+    int failed = 0;
+    unsigned int x;
+    unsigned int y;
+
+    fpf_reset_stats();
+    failed |= Check("reset", 0, 0, 0, 0);
+
+    fpf_create_alpha_texture(alpha_texture, sizeof(alpha_texture), FPF_TEXTURE_WIDTH, FPF_RASTER_Y_AXIS);
+    failed |= Check("alpha atlas", 0, 0, atlas_bytes, 0);
+
+    fpf_create_outline_texture(rg_texture, sizeof(rg_texture), FPF_OUTLINE_TEXTURE_WIDTH * 2, FPF_RASTER_Y_AXIS);
+    failed |= Check("outline atlas", 0, 0, atlas_bytes + outline_bytes, 0);
+
+    // Spaces aren't glyphs.
+    fpf_layout_text("Hi there", 8, 0.0f, 0.0f, 0xffffffffu, FPF_RASTER_Y_AXIS, vertices,
+        sizeof(vertices) / sizeof(vertices[0]));
+    failed |= Check("layout", 7, 0, atlas_bytes + outline_bytes, 1);
+
+    fpf_get_glyph_position('A', &x, &y);
+    fpf_get_glyph_position('\x01', &x, &y);
+    failed |= Check("glyph positions", 7, 1, atlas_bytes + outline_bytes, 1);
+
+    fpf_create_glyph_bits(glyph_bits);
+    fpf_draw_text_alpha8(glyph_bits, &surface[0][0], FPF_GLYPH_WIDTH * 16, FPF_GLYPH_HEIGHT * 2,
+        sizeof(surface[0]), 0, 0, "abc\ndef", 7, 0xff);
+    failed |= Check("software draw", 13, 1, atlas_bytes + outline_bytes, 1);
+
+    // Four workers composite 8 glyphs around the corner the four tiles share: 2 glyphs in each tile.
+    const fpf_draw_command command = { 52, 58, "abcd\nefgh", 9, 0xff };
+    pthread_t threads[WORKER_COUNT];
+    fpf_begin_composite(&compositor, glyph_bits, &composite_surface[0][0], 128, 128, sizeof(composite_surface[0]),
+        &command, 1, WORKER_COUNT);
+    for (unsigned int i = 0; i < WORKER_COUNT; ++i)
+    {
+        pthread_create(&threads[i], NULL, Composite, (void*)(size_t)i);
+    }
+    for (unsigned int i = 0; i < WORKER_COUNT; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    failed |= Check("composite", 13, 1, atlas_bytes + outline_bytes, 1);
+    failed |= (8 != fpf_end_composite(&compositor));
+    failed |= Check("end composite", 21, 1, atlas_bytes + outline_bytes, 1);
+
+    fpf_reset_stats();
+    failed |= Check("reset", 0, 0, 0, 0);
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
@@ -0,0 +1,173 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: subpixel drawing test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+
+// Creates subpixel masks with 1, 2 and 4 phases, draws text at fractional positions (including
+// text hanging off every edge), and checks every pixel against the blend of the text drawn at the
+// two whole pixels either side. Then times fractional against whole pixel drawing.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+#define SURFACE_WIDTH   61
+#define SURFACE_HEIGHT  23
+#define PAGE_WIDTH      640
+#define PAGE_HEIGHT     480
+#define PASSES          200
+
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+unsigned char masks[FPF_SUBPIXEL_MASKS_SIZE(FPF_MAX_SUBPIXEL_PHASES)];
+unsigned char left_surface[SURFACE_HEIGHT][SURFACE_WIDTH];
+unsigned char right_surface[SURFACE_HEIGHT][SURFACE_WIDTH];
+unsigned char subpixel_surface[SURFACE_HEIGHT][SURFACE_WIDTH];
+unsigned char page_surface[PAGE_HEIGHT * PAGE_WIDTH];
+char page[(PAGE_WIDTH / FPF_GLYPH_WIDTH + 1) * (PAGE_HEIGHT / FPF_GLYPH_HEIGHT)];
+
+const char text[] = "Subpixel TEXT\n~@#$%^&*()_+{}|:\"<>?\nlast line: 0123456789";
+
+double GetSeconds()
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    int failed = 0;
+    fpf_create_glyph_bits(glyph_bits);
+
+    // Too small a buffer reports the size needed.
+    const size_t two_phase_bytes = fpf_create_subpixel_masks(masks, 0, 2);
+    const size_t four_phase_bytes = fpf_create_subpixel_masks(masks, 0, 4);
+    failed |= (FPF_SUBPIXEL_MASKS_SIZE(2) != two_phase_bytes) || (FPF_SUBPIXEL_MASKS_SIZE(4) != four_phase_bytes);
+    printf("masks: %u bytes for 2 phases, %u bytes for 4 phases\n", (unsigned int)two_phase_bytes,
+        (unsigned int)four_phase_bytes);
+
+    const int positions[][2] = { { 2, 1 }, { -4, -3 }, { 40, 15 }, { -20, 10 }, { 57, 4 } };
+    const unsigned char alphas[] = { 0xff, 0x80 };
+    for (unsigned int phase_count = 1; phase_count <= FPF_MAX_SUBPIXEL_PHASES; phase_count *= 2)
+    {
+        int phase_failed = fpf_create_subpixel_masks(masks, sizeof(masks), phase_count) != 0;
+
+        for (unsigned int p = 0; p < sizeof(positions) / sizeof(positions[0]); ++p)
+        {
+            const int x = positions[p][0];
+            const int y = positions[p][1];
+
+            memset(left_surface, 0, sizeof(left_surface));
+            memset(right_surface, 0, sizeof(right_surface));
+            const size_t left_count = fpf_draw_text_alpha8(glyph_bits, &left_surface[0][0], SURFACE_WIDTH,
+                SURFACE_HEIGHT, SURFACE_WIDTH, x, y, text, sizeof(text) - 1, 0xff);
+            fpf_draw_text_alpha8(glyph_bits, &right_surface[0][0], SURFACE_WIDTH, SURFACE_HEIGHT, SURFACE_WIDTH,
+                x + 1, y, text, sizeof(text) - 1, 0xff);
+
+            for (unsigned int phase = 0; phase < phase_count; ++phase)
+            {
+                for (unsigned int a = 0; a < sizeof(alphas) / sizeof(alphas[0]); ++a)
+                {
+                    memset(subpixel_surface, 0, sizeof(subpixel_surface));
+                    const float subpixel_x = (float)x + (float)phase / (float)phase_count;
+                    const size_t count = fpf_draw_text_alpha8_subpixel(masks, phase_count, &subpixel_surface[0][0],
+                        SURFACE_WIDTH, SURFACE_HEIGHT, SURFACE_WIDTH, subpixel_x, y, text, sizeof(text) - 1,
+                        alphas[a]);
+                    phase_failed |= (0 == phase && count != left_count);
+
+                    // Every pixel is the two whole pixel positions mixed by the phase, then scaled by alpha.
+                    for (unsigned int row = 0; row < SURFACE_HEIGHT; ++row)
+                    {
+                        for (unsigned int column = 0; column < SURFACE_WIDTH; ++column)
+                        {
+                            const int mixed = (left_surface[row][column] * (int)(phase_count - phase) +
+                                right_surface[row][column] * (int)phase) / (int)phase_count;
+                            const int expected = mixed * alphas[a] / 0xff;
+                            const int difference = subpixel_surface[row][column] - expected;
+                            phase_failed |= (difference < -1 || difference > 1);
+                        }
+                    }
+
+                    // Phase 0 at full alpha is the bitmap font, exactly.
+                    if (0 == phase && 0xff == alphas[a])
+                    {
+                        phase_failed |= (0 != memcmp(subpixel_surface, left_surface, sizeof(left_surface)));
+                    }
+                }
+            }
+        }
+
+        printf("%u phase%s %s\n", phase_count, (1 == phase_count) ? "" : "s", phase_failed ? "FAILED" : "ok");
+        failed |= phase_failed;
+    }
+
+    // A page of text scrolling a quarter pixel per frame, against the same page at whole pixels.
+    char* p = page;
+    for (unsigned int line = 0; line < PAGE_HEIGHT / FPF_GLYPH_HEIGHT; ++line)
+    {
+        for (unsigned int column = 0; column < PAGE_WIDTH / FPF_GLYPH_WIDTH; ++column)
+        {
+            *p++ = (char)(33 + (line * 7 + column) % 94);
+        }
+        *p++ = '\n';
+    }
+    const size_t page_length = (size_t)(p - page);
+    fpf_create_subpixel_masks(masks, sizeof(masks), 4);
+
+    size_t glyph_count = 0;
+    double start = GetSeconds();
+    for (unsigned int pass = 0; pass < PASSES; ++pass)
+    {
+        glyph_count += fpf_draw_text_alpha8(glyph_bits, page_surface, PAGE_WIDTH, PAGE_HEIGHT, PAGE_WIDTH,
+            -(int)(pass % 4), 0, page, page_length, 0xff);
+    }
+    const double whole_seconds = GetSeconds() - start;
+
+    start = GetSeconds();
+    for (unsigned int pass = 0; pass < PASSES; ++pass)
+    {
+        glyph_count += fpf_draw_text_alpha8_subpixel(masks, 4, page_surface, PAGE_WIDTH, PAGE_HEIGHT, PAGE_WIDTH,
+            -0.25f * (float)(pass % 16), 0, page, page_length, 0xff);
+    }
+    const double subpixel_seconds = GetSeconds() - start;
+
+    printf("%u glyph page: whole pixels %.1f us, quarter pixels %.1f us (%u glyphs)\n",
+        (unsigned int)(page_length - PAGE_HEIGHT / FPF_GLYPH_HEIGHT), whole_seconds * 1e6 / PASSES,
+        subpixel_seconds * 1e6 / PASSES, (unsigned int)glyph_count);
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
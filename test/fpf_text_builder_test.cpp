@@ -0,0 +1,153 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: C++ text builder test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Lays out text with fpf::text_builder in a few vertex formats and checks it against
+// fpf_layout_text(), with a counting operator new to make sure nothing touches the heap.
+// Builds as C++17 or later; the test Makefile uses C++20 so the std::span overload is checked too.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+#include "fpf_text_builder.hpp"
+
+static std::size_t allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocation_count;
+    void* p = std::malloc(size ? size : 1);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+struct float2 { float x, y; };
+
+using list_format = fpf::vertex_format<float2, float2, std::uint32_t, fpf::primitive::triangle_list>;
+using strip_format = fpf::vertex_format<float2, float2, std::uint32_t, fpf::primitive::triangle_strip>;
+using instance_format = fpf::instance_format<float2, float2, std::uint32_t>;
+
+const char text[] = "Hello, world!\n\tfps: 59.94\x01";
+const std::size_t glyph_count = 22;
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    int failed = 0;
+
+    fpf_vertex expected[64 * FPF_VERTICES_PER_GLYPH];
+    const std::size_t expected_count = fpf_layout_text(text, sizeof(text) - 1, 4.0f, 8.0f, 0xff00ff00u,
+        FPF_VECTOR_Y_AXIS, expected, sizeof(expected) / sizeof(expected[0]));
+    failed |= (glyph_count * FPF_VERTICES_PER_GLYPH != expected_count);
+
+    std::vector<list_format::vertex_type> list_vertices(expected_count);
+    std::vector<strip_format::vertex_type> strip_vertices(glyph_count * 6);
+    std::vector<instance_format::vertex_type> instances(glyph_count);
+    fpf_vertex c_vertices[64 * FPF_VERTICES_PER_GLYPH];
+    const std::size_t allocations_before = allocation_count;
+
+    // The library's own vertex through an output iterator: identical to fpf_layout_text().
+    fpf::text_builder<fpf::fpf_vertex_format> c_builder(4.0f, 8.0f, 0xff00ff00u, FPF_VECTOR_Y_AXIS);
+    const fpf_vertex* const p_c_end = c_builder.append(text, c_vertices);
+    failed |= (expected_count != (std::size_t)(p_c_end - c_vertices));
+    failed |= (0 != std::memcmp(expected, c_vertices, expected_count * sizeof(fpf_vertex)));
+
+    // A custom format into a bounded buffer.
+    fpf::text_builder<list_format> list_builder(4.0f, 8.0f, 0xff00ff00u, FPF_VECTOR_Y_AXIS);
+    failed |= (expected_count != list_builder.append(text, list_vertices.data(), list_vertices.size()));
+    for (std::size_t i = 0; i < expected_count; ++i)
+    {
+        failed |= (expected[i].x != list_vertices[i].position.x || expected[i].y != list_vertices[i].position.y);
+        failed |= (expected[i].u != list_vertices[i].tex_coord.x || expected[i].v != list_vertices[i].tex_coord.y);
+        failed |= (expected[i].color != list_vertices[i].color);
+    }
+
+    // Triangle strip: each glyph is its quad's corners with the first and last repeated.
+    fpf::text_builder<strip_format> strip_builder(4.0f, 8.0f, 0xff00ff00u, FPF_VECTOR_Y_AXIS);
+    failed |= (strip_vertices.size() != strip_builder.append(text, strip_vertices.data(), strip_vertices.size()));
+    for (std::size_t i = 0; i < glyph_count; ++i)
+    {
+        const fpf_vertex* const p_quad = &expected[i * FPF_VERTICES_PER_GLYPH];
+        const strip_format::vertex_type* const p_strip = &strip_vertices[i * 6];
+        const int corners[6] = { 0, 0, 1, 2, 5, 5 };
+        for (int k = 0; k < 6; ++k)
+        {
+            failed |= (p_quad[corners[k]].x != p_strip[k].position.x || p_quad[corners[k]].v != p_strip[k].tex_coord.y);
+        }
+    }
+
+    // Instances: one per glyph.
+    fpf::text_builder<instance_format> instance_builder(4.0f, 8.0f, 0xff00ff00u, FPF_VECTOR_Y_AXIS);
+    failed |= (glyph_count != instance_builder.append(text, instances.data(), instances.size()));
+    for (std::size_t i = 0; i < glyph_count; ++i)
+    {
+        const fpf_vertex* const p_quad = &expected[i * FPF_VERTICES_PER_GLYPH];
+        failed |= (p_quad[0].x != instances[i].top_left.x || p_quad[5].y != instances[i].bottom_right.y);
+        failed |= (p_quad[0].u != instances[i].tex_top_left.x || p_quad[5].v != instances[i].tex_bottom_right.y);
+    }
+
+    // A full buffer stops between glyphs, leaving the pen at the glyph that didn't fit.
+    fpf::text_builder<list_format> short_builder(0.0f, 0.0f, 0xffffffffu);
+    failed |= (3 * FPF_VERTICES_PER_GLYPH != short_builder.append("abc def", list_vertices.data(), 4 * FPF_VERTICES_PER_GLYPH - 1));
+    failed |= (4.0f * FPF_GLYPH_WIDTH != short_builder.pen_x());
+
+#if __cplusplus >= 202002L
+    // Straight into a std::span.
+    fpf::text_builder<list_format> span_builder(4.0f, 8.0f, 0xff00ff00u, FPF_VECTOR_Y_AXIS);
+    failed |= (expected_count != span_builder.append(text, std::span<list_format::vertex_type>(list_vertices)));
+#endif
+
+    failed |= (allocations_before != allocation_count);
+
+    printf("%u glyphs, %u heap allocations while building\n", (unsigned int)glyph_count,
+        (unsigned int)(allocation_count - allocations_before));
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
@@ -0,0 +1,155 @@
+// -----------------------------------------------------------------------
+// Benchmark of fpf_create_alpha_texture() against fpf_create_alpha_texture_streaming().
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Simulates uploading the atlas straight into an uncached, write-combined staging buffer. Every
+// line of the destination is flushed from the cache before each pass, so ordinary stores have
+// to fetch lines back in (a read the GPU mapping can't serve cheaply), while streaming stores
+// write whole lines without reading.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+#ifdef FPF_SSE2
+#define FlushLine(p) _mm_clflush(p)
+#define FlushFence() _mm_mfence()
+#else
+#define FlushLine(p) ((void)(p))
+#define FlushFence() ((void)0)
+#endif
+
+typedef size_t (*create_texture_function)(unsigned char *const, const size_t, const size_t, const fpf_y_axis_direction);
+
+const unsigned int passes = 20000;
+
+double GetSeconds()
+{
+#ifdef WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+void FlushBuffer(const unsigned char* p, const size_t size)
+{
+    size_t offset;
+    for (offset = 0; offset < size; offset += 64)
+    {
+        FlushLine(p + offset);
+    }
+    FlushFence();
+}
+
+double TimeUploads(
+    create_texture_function create_texture,
+    unsigned char* p,
+    const size_t size,
+    const size_t line_pitch,
+    const fpf_y_axis_direction y_axis_direction
+    )
+{
+    double total = 0.0;
+    unsigned int pass;
+    for (pass = 0; pass < passes; ++pass)
+    {
+        FlushBuffer(p, size);
+        const double start = GetSeconds();
+        create_texture(p, size, line_pitch, y_axis_direction);
+        total += GetSeconds() - start;
+    }
+    return total / passes;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    const size_t pitches[] = { FPF_TEXTURE_WIDTH, 128, 256 };
+    const fpf_y_axis_direction directions[] = { FPF_RASTER_Y_AXIS, FPF_VECTOR_Y_AXIS };
+    int failed = 0;
+
+    for (unsigned int k = 0; k < sizeof(pitches) / sizeof(pitches[0]); ++k)
+    {
+        for (unsigned int j = 0; j < 2; ++j)
+        {
+            const size_t line_pitch = pitches[k];
+            const size_t size = line_pitch * FPF_TEXTURE_HEIGHT;
+
+            // Line up the buffers the way a GPU driver would map them.
+            unsigned char* reference = (unsigned char*)malloc(size + 64);
+            unsigned char* staging = (unsigned char*)malloc(size + 64);
+            unsigned char* aligned_reference = reference + (64 - ((size_t)reference & 63));
+            unsigned char* aligned_staging = staging + (64 - ((size_t)staging & 63));
+
+            // Texels outside the atlas must be left alone by both functions.
+            memset(aligned_reference, 0xcc, size);
+            memset(aligned_staging, 0xcc, size);
+
+            const double reference_seconds = TimeUploads(
+                fpf_create_alpha_texture, aligned_reference, size, line_pitch, directions[j]);
+            const double staging_seconds = TimeUploads(
+                fpf_create_alpha_texture_streaming, aligned_staging, size, line_pitch, directions[j]);
+
+            const int same = (0 == memcmp(aligned_reference, aligned_staging, size));
+            failed |= !same;
+
+            printf("pitch %3u %s: byte-wise %8.1f ns, streaming %8.1f ns, %5.2fx%s\n",
+                (unsigned int)line_pitch,
+                (FPF_RASTER_Y_AXIS == directions[j]) ? "raster" : "vector",
+                reference_seconds * 1e9,
+                staging_seconds * 1e9,
+                reference_seconds / staging_seconds,
+                same ? "" : "  MISMATCH");
+
+            free(reference);
+            free(staging);
+        }
+    }
+
+    return failed;
+}
@@ -0,0 +1,125 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: UTF-8 and code page input test
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Converts UTF-8, Latin-1 and code page 437 text to glyph indices and checks them: accented
+// letters and box-drawing characters map to the nearest glyph, anything else gets one fallback
+// glyph per code point, and long ASCII runs (the SIMD fast path) match the scalar result.
+
+#include <stdio.h>
+#include <string.h>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+int check(const char* name, const unsigned char* glyph_indices, size_t count, const char* expected)
+{
+    // Expected glyphs are written as ASCII, with '#' for the block cursor, '@' for the fallback glyph and '/' for a newline.
+    int failed = (strlen(expected) != count);
+    for (size_t i = 0; !failed && i < count; ++i)
+    {
+        const unsigned int glyph_index =
+            ('#' == expected[i]) ? FPF_CURSOR_GLYPH(FPF_BLOCK_CURSOR) :
+            ('@' == expected[i]) ? FPF_ASCII_GLYPH('\x7f') :
+            ('/' == expected[i]) ? FPF_NEWLINE_GLYPH :
+            FPF_ASCII_GLYPH(expected[i]);
+        failed |= (glyph_index != glyph_indices[i]);
+    }
+    printf("%-10s %s\n", name, failed ? "FAILED" : "ok");
+    return failed;
+}
+
+int main(int argc, char* argv[])
+{
+    (void)(argc);
+    (void)(argv);
+
+    int failed = 0;
+    unsigned char glyph_indices[256];
+    size_t count;
+    size_t bytes_used;
+
+    // Latin-1 letters, typographic punctuation, a BOM (no glyph), a Greek letter with no
+    // replacement, a 4-byte emoji and a malformed byte.
+    const char utf8[] = "\xef\xbb\xbf" "Cr\xc3\xa8me br\xc3\xbbl\xc3\xa9" "e \xe2\x80\x94 \xe2\x80\x9cok\xe2\x80\x9d\n"
+                        "\xce\xbb \xf0\x9f\x98\x80 \xff \xe2\x94\x8c\xe2\x94\x80\xe2\x94\x90 \xe2\x96\x88";
+    count = fpf_utf8_to_glyph_indices(utf8, sizeof(utf8) - 1, NULL, 0, glyph_indices, sizeof(glyph_indices), &bytes_used);
+    failed |= check("utf-8", glyph_indices, count, "Creme brulee - \"ok\"/@ @ @ +-+ #");
+    failed |= (sizeof(utf8) - 1 != bytes_used);
+
+    // A full output buffer never splits a code point.
+    count = fpf_utf8_to_glyph_indices(utf8 + 3, sizeof(utf8) - 4, NULL, 0, glyph_indices, 3, &bytes_used);
+    failed |= check("truncated", glyph_indices, count, "Cre");
+    failed |= (4 != bytes_used);
+
+    const char latin1[] = "na\xefve \xa9 caf\xe9";
+    count = fpf_code_page_to_glyph_indices(latin1, sizeof(latin1) - 1, NULL, NULL, 0, glyph_indices, sizeof(glyph_indices));
+    failed |= check("latin-1", glyph_indices, count, "naive C cafe");
+
+    const char cp437[] = "\xc9\xcd\xbb \xba\x81\xba \xc8\xcd\xbc \xdb\xb1";
+    count = fpf_code_page_to_glyph_indices(cp437, sizeof(cp437) - 1, fpf_cp437_code_points, NULL, 0, glyph_indices,
+        sizeof(glyph_indices));
+    failed |= check("cp437", glyph_indices, count, "+=+ |u| +=+ #@");
+
+    // A custom replacement table.
+    const fpf_replacement arrows[] = { { 0x2190, 0x2190, FPF_ASCII_GLYPH('{') }, { 0x2192, 0x2192, FPF_ASCII_GLYPH('}') } };
+    const char arrow_text[] = "\xe2\x86\x90\xe2\x86\x92\xe2\x86\x91";
+    count = fpf_utf8_to_glyph_indices(arrow_text, sizeof(arrow_text) - 1, arrows, 2, glyph_indices, sizeof(glyph_indices), NULL);
+    failed |= check("custom", glyph_indices, count, "{}@");
+
+    // Long ASCII runs go through the SIMD fast path; they must match one character at a time.
+    char ascii[200];
+    for (unsigned int i = 0; i < sizeof(ascii); ++i)
+    {
+        ascii[i] = (char)((0 == i % 61) ? '\n' : ' ' + (i * 7) % 95);
+    }
+    count = fpf_utf8_to_glyph_indices(ascii, sizeof(ascii), NULL, 0, glyph_indices, sizeof(glyph_indices), NULL);
+    int ascii_failed = (sizeof(ascii) != count);
+    for (unsigned int i = 0; !ascii_failed && i < sizeof(ascii); ++i)
+    {
+        ascii_failed |= (fpf_get_code_point_glyph_index((unsigned char)ascii[i], NULL, 0) != glyph_indices[i]);
+    }
+    printf("%-10s %s\n", "ascii", ascii_failed ? "FAILED" : "ok");
+    failed |= ascii_failed;
+
+    // UTF-8 layout emits one quad per visible code point.
+    fpf_vertex vertices[64 * FPF_VERTICES_PER_GLYPH];
+    const size_t vertex_count = fpf_layout_utf8_text(utf8, sizeof(utf8) - 1, 0.0f, 0.0f, 0xffffffff, FPF_RASTER_Y_AXIS,
+        vertices, sizeof(vertices) / sizeof(vertices[0]));
+    failed |= (23 * FPF_VERTICES_PER_GLYPH != vertex_count);
+    failed |= (FPF_GLYPH_HEIGHT != vertices[vertex_count - FPF_VERTICES_PER_GLYPH].y);
+
+    // A buffer with a few vertices to spare past the last whole glyph stops at that glyph.
+    const size_t partial_count = fpf_layout_utf8_text(utf8, sizeof(utf8) - 1, 0.0f, 0.0f, 0xffffffff,
+        FPF_RASTER_Y_AXIS, vertices, 10 * FPF_VERTICES_PER_GLYPH + 3);
+    failed |= (10 * FPF_VERTICES_PER_GLYPH != partial_count);
+
+    printf(failed ? "FAILED\n" : "passed\n");
+    return failed;
+}
@@ -0,0 +1,468 @@
+// -----------------------------------------------------------------------
+// five-pixel-font library: headless OpenGL benchmark
+// by Chris Gassib
+// -----------------------------------------------------------------------
+// This is free and unencumbered software released into the public domain.
+// 
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software, either in source code form or as a compiled
+// binary, for any purpose, commercial or non-commercial, and by any
+// means.
+// 
+// In jurisdictions that recognize copyright laws, the author or authors
+// of this software dedicate any and all copyright interest in the
+// software to the public domain. We make this dedication for the benefit
+// of the public at large and to the detriment of our heirs and
+// successors. We intend this dedication to be an overt act of
+// relinquishment in perpetuity of all present and future rights to this
+// software under copyright law.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+// OTHER DEALINGS IN THE SOFTWARE.
+// 
+// For more information, please refer to <http://unlicense.org/>
+
+
+// Draws a full 1920x1080 screen of text (320x180 cells, changing every frame) four ways on a
+// headless OpenGL 3.3 context (EGL, surfaceless; Mesa's llvmpipe needs no GPU), and reports
+// frames/s, draw calls and uploaded bytes for each:
+//
+//  per-glyph   One draw call per glyph; the glyph's rectangle and texture coordinates are uniforms.
+//  batched     fpf_layout_text() quads for the whole screen, uploaded and drawn in one call.
+//  instanced   One 4-byte instance per glyph (cell column, row and glyph index); one call.
+//  grid        A cell grid texture of glyph indices; one full-screen triangle looks up the atlas.
+//
+// Each approach's first frame is read back and checked against fpf_draw_text_alpha8().
+//
+// usage: gl_bench [--seconds S]    (default 1 second per approach)
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#define FPF_IMPLEMENTATION
+#include "five_pixel_font.h"
+
+#define SCREEN_WIDTH    1920
+#define SCREEN_HEIGHT   1080
+#define COLUMNS         (SCREEN_WIDTH / FPF_GLYPH_WIDTH)
+#define ROWS            (SCREEN_HEIGHT / FPF_GLYPH_HEIGHT)
+#define EMPTY_CELL      255
+
+char text[ROWS * (COLUMNS + 1)];
+fpf_vertex vertices[ROWS * COLUMNS * FPF_VERTICES_PER_GLYPH];
+unsigned int instances[ROWS * COLUMNS];
+unsigned char grid[ROWS * COLUMNS];
+unsigned char alpha_texture[FPF_TEXTURE_WIDTH * FPF_TEXTURE_HEIGHT];
+unsigned char glyph_bits[FPF_GLYPH_BITS_SIZE];
+unsigned char expected[SCREEN_WIDTH * SCREEN_HEIGHT];
+unsigned char pixels[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+// Every approach draws into the same 8-bit render target; pixel (0, 0) is the top-left. The
+// shaders are written for the 1920x1080 screen.
+const char* const quad_vertex_shader =
+    "#version 330 core\n"
+    "layout(location = 0) in vec2 position;\n"
+    "layout(location = 1) in vec2 uv;\n"
+    "uniform vec4 rect;\n"      // Per-glyph: x, y, width, height in pixels; batched: 0, 0, 1, 1.
+    "uniform vec4 uv_rect;\n"   // Per-glyph: u0, v0, u1 - u0, v1 - v0; batched: 0, 0, 1, 1.
+    "out vec2 texture_uv;\n"
+    "void main() {\n"
+    "    vec2 pixel = rect.xy + position * rect.zw;\n"
+    "    texture_uv = uv_rect.xy + uv * uv_rect.zw;\n"
+    "    gl_Position = vec4(pixel.x / 960.0 - 1.0, 1.0 - pixel.y / 540.0, 0.0, 1.0);\n"
+    "}\n";
+
+const char* const instance_vertex_shader =
+    "#version 330 core\n"
+    "layout(location = 2) in uint cell;\n" // Column | row << 10 | glyph index << 20.
+    "out vec2 atlas_texel;\n"
+    "void main() {\n"
+    "    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 6.0;\n"
+    "    uint glyph = cell >> 20u;\n"
+    "    vec2 pixel = vec2(cell & 1023u, (cell >> 10u) & 1023u) * 6.0 + corner;\n"
+    "    atlas_texel = vec2(glyph % 10u, glyph / 10u) * 6.0 + corner;\n"
+    "    gl_Position = vec4(pixel.x / 960.0 - 1.0, 1.0 - pixel.y / 540.0, 0.0, 1.0);\n"
+    "}\n";
+
+const char* const grid_vertex_shader =
+    "#version 330 core\n"
+    "void main() {\n"
+    "    gl_Position = vec4(vec2(gl_VertexID & 1, gl_VertexID >> 1) * 4.0 - 1.0, 0.0, 1.0);\n"
+    "}\n";
+
+const char* const sample_fragment_shader =
+    "#version 330 core\n"
+    "uniform sampler2D atlas;\n"
+    "in vec2 texture_uv;\n"
+    "out vec4 color;\n"
+    "void main() { color = vec4(texture(atlas, texture_uv).r); }\n";
+
+const char* const fetch_fragment_shader =
+    "#version 330 core\n"
+    "uniform sampler2D atlas;\n"
+    "in vec2 atlas_texel;\n"
+    "out vec4 color;\n"
+    "void main() { color = vec4(texelFetch(atlas, ivec2(atlas_texel), 0).r); }\n";
+
+const char* const grid_fragment_shader =
+    "#version 330 core\n"
+    "uniform sampler2D atlas;\n"
+    "uniform usampler2D cells;\n"
+    "out vec4 color;\n"
+    "void main() {\n"
+    "    ivec2 pixel = ivec2(gl_FragCoord.xy);\n"
+    "    pixel.y = 1079 - pixel.y;\n"
+    "    uint glyph = texelFetch(cells, pixel / 6, 0).r;\n"
+    "    if (glyph == 255u) { color = vec4(0.0); return; }\n"
+    "    ivec2 texel = ivec2(int(glyph % 10u), int(glyph / 10u)) * 6 + pixel % 6;\n"
+    "    color = vec4(texelFetch(atlas, texel, 0).r);\n"
+    "}\n";
+
+typedef struct
+{
+    size_t draw_calls;
+    size_t uploaded_bytes;
+} frame_stats;
+
+GLuint programs[4];
+GLuint unit_quad_buffer;
+GLuint vertex_buffer;
+GLuint instance_buffer;
+GLuint grid_texture;
+
+double GetSeconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+GLuint CompileProgram(const char* vertex_source, const char* fragment_source)
+{
+    const char* sources[2] = { vertex_source, fragment_source };
+    const GLenum types[2] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+    const GLuint program = glCreateProgram();
+    char log[1024];
+    GLint ok;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        const GLuint shader = glCreateShader(types[i]);
+        glShaderSource(shader, 1, &sources[i], NULL);
+        glCompileShader(shader);
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (!ok)
+        {
+            glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+            printf("shader error: %s\n", log);
+            return 0;
+        }
+        glAttachShader(program, shader);
+        glDeleteShader(shader);
+    }
+
+    glLinkProgram(program);
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok)
+    {
+        glGetProgramInfoLog(program, sizeof(log), NULL, log);
+        printf("link error: %s\n", log);
+        return 0;
+    }
+
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "atlas"), 0);
+    glUniform1i(glGetUniformLocation(program, "cells"), 1);
+    return program;
+}
+
+// Fills the screen with log-like text that scrolls by one line and changes digits every frame.
+void MakeText(unsigned int frame)
+{
+    for (unsigned int row = 0; row < ROWS; ++row)
+    {
+        char* const line = &text[row * (COLUMNS + 1)];
+        const unsigned int seed = row + frame;
+
+        for (unsigned int column = 0; column < COLUMNS; ++column)
+        {
+            line[column] = (0 == (seed + column) % 11) ? ' ' : (char)('!' + (seed * 31 + column * 7) % 94);
+        }
+        char label[32];
+        memcpy(line, label, (size_t)snprintf(label, sizeof(label), "%05u frame %07u", seed, frame));
+        line[COLUMNS] = '\n';
+    }
+}
+
+void DrawPerGlyph(frame_stats* p_stats)
+{
+    glUseProgram(programs[0]);
+    glBindBuffer(GL_ARRAY_BUFFER, unit_quad_buffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+
+    const GLint rect = glGetUniformLocation(programs[0], "rect");
+    const GLint uv_rect = glGetUniformLocation(programs[0], "uv_rect");
+
+    for (unsigned int row = 0; row < ROWS; ++row)
+    {
+        for (unsigned int column = 0; column < COLUMNS; ++column)
+        {
+            const char character = text[row * (COLUMNS + 1) + column];
+            float left, top, right, bottom;
+
+            if (' ' == character)
+            {
+                continue;
+            }
+
+            fpf_get_glyph_dx_texture_coordinates(character, &left, &top, &right, &bottom);
+            glUniform4f(rect, (float)(column * FPF_GLYPH_WIDTH), (float)(row * FPF_GLYPH_HEIGHT),
+                        (float)FPF_GLYPH_WIDTH, (float)FPF_GLYPH_HEIGHT);
+            glUniform4f(uv_rect, left, top, right - left, bottom - top);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            p_stats->draw_calls += 1;
+            p_stats->uploaded_bytes += 8 * sizeof(float);
+        }
+    }
+
+    glDisableVertexAttribArray(1);
+}
+
+void DrawBatched(frame_stats* p_stats)
+{
+    const size_t vertex_count = fpf_layout_text(text, sizeof(text), 0.0f, 0.0f, 0xffffffffu, FPF_RASTER_Y_AXIS,
+                                                vertices, sizeof(vertices) / sizeof(vertices[0]));
+
+    glUseProgram(programs[1]);
+    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+    glBufferData(GL_ARRAY_BUFFER, vertex_count * sizeof(fpf_vertex), vertices, GL_STREAM_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(fpf_vertex), (void*)offsetof(fpf_vertex, x));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(fpf_vertex), (void*)offsetof(fpf_vertex, u));
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vertex_count);
+    glDisableVertexAttribArray(0);
+    glDisableVertexAttribArray(1);
+
+    p_stats->draw_calls += 1;
+    p_stats->uploaded_bytes += vertex_count * sizeof(fpf_vertex);
+}
+
+void DrawInstanced(frame_stats* p_stats)
+{
+    size_t instance_count = 0;
+
+    for (unsigned int row = 0; row < ROWS; ++row)
+    {
+        for (unsigned int column = 0; column < COLUMNS; ++column)
+        {
+            const char character = text[row * (COLUMNS + 1) + column];
+            if (' ' != character)
+            {
+                instances[instance_count++] = column | row << 10 | fpf_get_glyph_index(character) << 20;
+            }
+        }
+    }
+
+    glUseProgram(programs[2]);
+    glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+    glBufferData(GL_ARRAY_BUFFER, instance_count * sizeof(instances[0]), instances, GL_STREAM_DRAW);
+    glVertexAttribIPointer(2, 1, GL_UNSIGNED_INT, sizeof(instances[0]), (void*)0);
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(2);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)instance_count);
+    glDisableVertexAttribArray(2);
+
+    p_stats->draw_calls += 1;
+    p_stats->uploaded_bytes += instance_count * sizeof(instances[0]);
+}
+
+void DrawGrid(frame_stats* p_stats)
+{
+    for (unsigned int row = 0; row < ROWS; ++row)
+    {
+        for (unsigned int column = 0; column < COLUMNS; ++column)
+        {
+            const char character = text[row * (COLUMNS + 1) + column];
+            grid[row * COLUMNS + column] = (' ' == character) ? EMPTY_CELL : (unsigned char)fpf_get_glyph_index(character);
+        }
+    }
+
+    glUseProgram(programs[3]);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, grid_texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, COLUMNS, ROWS, GL_RED_INTEGER, GL_UNSIGNED_BYTE, grid);
+    glActiveTexture(GL_TEXTURE0);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    p_stats->draw_calls += 1;
+    p_stats->uploaded_bytes += sizeof(grid);
+}
+
+int main(int argc, char* argv[])
+{
+    const char* const names[4] = { "per-glyph", "batched", "instanced", "grid" };
+    void (* const draws[4])(frame_stats*) = { DrawPerGlyph, DrawBatched, DrawInstanced, DrawGrid };
+    const float unit_quad[] = { 0, 0, 0, 0,  1, 0, 1, 0,  0, 1, 0, 1,  1, 1, 1, 1 };
+    double seconds_per_approach = 1.0;
+    int failed = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (0 == strcmp(argv[i], "--seconds") && i + 1 < argc)
+        {
+            seconds_per_approach = atof(argv[++i]);
+        }
+    }
+
+    // A surfaceless EGL display needs no window system; fall back to the default display.
+    PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    EGLDisplay display = (NULL != get_platform_display) ?
+        get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL) : EGL_NO_DISPLAY;
+    if (EGL_NO_DISPLAY == display)
+    {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    const EGLint config_attributes[] = { EGL_SURFACE_TYPE, 0, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    const EGLint context_attributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE };
+    EGLConfig config;
+    EGLint config_count = 0;
+    EGLContext context = EGL_NO_CONTEXT;
+
+    if (EGL_NO_DISPLAY != display && eglInitialize(display, NULL, NULL) && eglBindAPI(EGL_OPENGL_API) &&
+        eglChooseConfig(display, config_attributes, &config, 1, &config_count) && 0 < config_count)
+    {
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+    }
+
+    if (EGL_NO_CONTEXT == context || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+    {
+        printf("no OpenGL 3.3 context available through EGL (error 0x%x); skipped\n", eglGetError());
+        return 0;
+    }
+
+    printf("renderer: %s\n", (const char*)glGetString(GL_RENDERER));
+
+    // Render target.
+    GLuint framebuffer, color_buffer, vertex_array, atlas;
+    glGenFramebuffers(1, &framebuffer);
+    glGenRenderbuffers(1, &color_buffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, color_buffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_R8, SCREEN_WIDTH, SCREEN_HEIGHT);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_buffer);
+    glViewport(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    glGenVertexArrays(1, &vertex_array);
+    glBindVertexArray(vertex_array);
+
+    // Font atlas (uploaded once, so not counted below) and the cell grid.
+    fpf_create_alpha_texture(alpha_texture, sizeof(alpha_texture), FPF_TEXTURE_WIDTH, FPF_RASTER_Y_AXIS);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glGenTextures(1, &atlas);
+    glBindTexture(GL_TEXTURE_2D, atlas);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, FPF_TEXTURE_WIDTH, FPF_TEXTURE_HEIGHT, 0, GL_RED, GL_UNSIGNED_BYTE,
+                 alpha_texture);
+
+    glActiveTexture(GL_TEXTURE1);
+    glGenTextures(1, &grid_texture);
+    glBindTexture(GL_TEXTURE_2D, grid_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, COLUMNS, ROWS, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, NULL);
+    glActiveTexture(GL_TEXTURE0);
+
+    glGenBuffers(1, &unit_quad_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, unit_quad_buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(unit_quad), unit_quad, GL_STATIC_DRAW);
+    glGenBuffers(1, &vertex_buffer);
+    glGenBuffers(1, &instance_buffer);
+
+    programs[0] = CompileProgram(quad_vertex_shader, sample_fragment_shader);
+    programs[1] = CompileProgram(quad_vertex_shader, sample_fragment_shader);
+    glUniform4f(glGetUniformLocation(programs[1], "rect"), 0.0f, 0.0f, 1.0f, 1.0f);
+    glUniform4f(glGetUniformLocation(programs[1], "uv_rect"), 0.0f, 0.0f, 1.0f, 1.0f);
+    programs[2] = CompileProgram(instance_vertex_shader, fetch_fragment_shader);
+    programs[3] = CompileProgram(grid_vertex_shader, grid_fragment_shader);
+    if (0 == programs[0] || 0 == programs[1] || 0 == programs[2] || 0 == programs[3])
+    {
+        printf("FAILED\n");
+        return 1;
+    }
+
+    // What the first frame should look like.
+    fpf_create_glyph_bits(glyph_bits);
+    MakeText(0);
+    fpf_draw_text_alpha8(glyph_bits, expected, SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_WIDTH, 0, 0, text, sizeof(text), 0xff);
+
+    printf("%u x %u pixels, %u x %u cells\n\n", SCREEN_WIDTH, SCREEN_HEIGHT, COLUMNS, ROWS);
+    printf("%-10s %10s %12s %16s %8s\n", "approach", "frames/s", "draws/frame", "uploaded B/frame", "image");
+
+    for (int approach = 0; approach < 4; ++approach)
+    {
+        frame_stats stats = { 0, 0 };
+        unsigned int frame = 0;
+        int matches = 1;
+
+        // First frame: check it.
+        MakeText(0);
+        glClear(GL_COLOR_BUFFER_BIT);
+        draws[approach](&stats);
+        glReadPixels(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, GL_RED, GL_UNSIGNED_BYTE, pixels);
+        for (unsigned int y = 0; y < SCREEN_HEIGHT; ++y)
+        {
+            if (0 != memcmp(&pixels[(SCREEN_HEIGHT - 1 - y) * SCREEN_WIDTH], &expected[y * SCREEN_WIDTH], SCREEN_WIDTH))
+            {
+                matches = 0;
+                failed = 1;
+                break;
+            }
+        }
+
+        // Then as many frames as fit in the time, each with new text.
+        stats.draw_calls = 0;
+        stats.uploaded_bytes = 0;
+        const double start = GetSeconds();
+        double elapsed;
+        do
+        {
+            MakeText(++frame);
+            glClear(GL_COLOR_BUFFER_BIT);
+            draws[approach](&stats);
+            glFinish();
+            elapsed = GetSeconds() - start;
+        } while (elapsed < seconds_per_approach || frame < 3);
+
+        printf("%-10s %10.1f %12zu %16zu %8s\n", names[approach], frame / elapsed, stats.draw_calls / frame,
+               stats.uploaded_bytes / frame, matches ? "matches" : "DIFFERS");
+    }
+
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+    eglTerminate(display);
+
+    printf(failed ? "\nFAILED\n" : "\npassed\n");
+    return failed;
+}